@@ -0,0 +1,69 @@
+// 10M random 8-byte keys through s21::btree_set, s21::set and std::set:
+// inserts, successful lookups, a full in-order walk and erasing half.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <set>
+#include <vector>
+
+#include "../s21_btree_set.h"
+#include "../s21_set.h"
+
+namespace {
+std::vector<std::int64_t> random_keys(std::size_t n, std::uint64_t seed) {
+  std::vector<std::int64_t> keys(n);
+  for (auto& key : keys) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    key = static_cast<std::int64_t>(seed >> 1);
+  }
+  return keys;
+}
+
+template <typename Run>
+double time_of(Run run) {
+  auto start = std::chrono::steady_clock::now();
+  run();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+template <typename Set>
+void measure(const char* name, const std::vector<std::int64_t>& keys,
+             const std::vector<std::int64_t>& probes) {
+  Set set;
+  double insert = time_of([&] {
+    for (std::int64_t key : keys) set.insert(key);
+  });
+  std::size_t found = 0;
+  double find = time_of([&] {
+    for (std::int64_t key : probes) found += set.find(key) != set.end();
+  });
+  std::int64_t sum = 0;
+  double walk = time_of([&] {
+    for (std::int64_t key : set) sum += key;
+  });
+  double erase = time_of([&] {
+    for (std::size_t i = 0; i < keys.size(); i += 2)
+      set.erase(set.find(keys[i]));
+  });
+  std::printf("  %-16s insert %6.2f s  find %6.2f s  walk %6.3f s  "
+              "erase %6.2f s  (%zu found, %zu left, sum %lld)\n",
+              name, insert, find, walk, erase, found, set.size(),
+              static_cast<long long>(sum));
+}
+}  // namespace
+
+int main() {
+  const std::size_t n = 10000000;
+  std::vector<std::int64_t> keys = random_keys(n, 88172645463325252ull);
+  std::vector<std::int64_t> probes(keys.rbegin(), keys.rend());
+  std::printf("%zu random int64 keys\n", n);
+  measure<s21::btree_set<std::int64_t>>("s21::btree_set", keys, probes);
+  measure<s21::set<std::int64_t>>("s21::set", keys, probes);
+  measure<std::set<std::int64_t>>("std::set", keys, probes);
+  return 0;
+}
@@ -0,0 +1,42 @@
+// Building s21::set from sorted keys: one insert per key against the linear
+// assign_sorted() path, with std::set's range constructor for reference.
+
+#include <chrono>
+#include <cstdio>
+#include <set>
+#include <vector>
+
+#include "../s21_set.h"
+
+namespace {
+template <typename Build>
+double time_of(Build build) {
+  auto start = std::chrono::steady_clock::now();
+  build();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+}  // namespace
+
+int main() {
+  const int n = 10000000;
+  std::vector<int> keys(n);
+  for (int i = 0; i < n; ++i) keys[i] = i;
+
+  double inserts = time_of([&keys] {
+    s21::set<int> set;
+    for (int key : keys) set.insert(key);
+  });
+  double bulk = time_of([&keys] {
+    s21::set<int> set;
+    set.assign_sorted(keys.begin(), keys.end());
+  });
+  double std_range =
+      time_of([&keys] { std::set<int> set(keys.begin(), keys.end()); });
+  std::printf("build from %d sorted keys\n", n);
+  std::printf("  s21::set insert() loop : %8.3f s\n", inserts);
+  std::printf("  s21::set assign_sorted : %8.3f s\n", bulk);
+  std::printf("  std::set range ctor    : %8.3f s\n", std_range);
+  return 0;
+}
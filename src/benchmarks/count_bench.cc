@@ -0,0 +1,47 @@
+// multiset::count on 5M entries: s21::multiset with and without subtree
+// sizes, next to std::multiset. Half of the probed keys are absent.
+
+#include <chrono>
+#include <cstdio>
+#include <set>
+
+#include "../s21_multiset.h"
+
+namespace {
+template <typename Set>
+double probe(const Set& set, int keys, int calls, std::size_t& total) {
+  auto start = std::chrono::steady_clock::now();
+  unsigned seed = 12345;
+  for (int i = 0; i < calls; ++i) {
+    seed = seed * 1103515245 + 12345;
+    total += set.count(static_cast<int>((seed >> 1) % (2u * keys)));
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+}  // namespace
+
+int main() {
+  const int n = 5000000, keys = n / 5, calls = 1000000;
+  s21::multiset<int> plain;
+  s21::multiset<int, std::less<int>, std::allocator<int>, true> ranked;
+  std::multiset<int> reference;
+  for (int i = 0; i < n; ++i) {
+    plain.insert(i % keys);
+    ranked.insert(i % keys);
+    reference.insert(i % keys);
+  }
+  std::size_t a = 0, b = 0, c = 0;
+  double plain_time = probe(plain, keys, calls, a);
+  double ranked_time = probe(ranked, keys, calls, b);
+  double std_time = probe(reference, keys, calls, c);
+  std::printf("%d count() calls on %d entries\n", calls, n);
+  std::printf("  s21::multiset              : %8.3f s  %6.0f ns/call  (%zu)\n",
+              plain_time, plain_time / calls * 1e9, a);
+  std::printf("  s21::multiset with sizes   : %8.3f s  %6.0f ns/call  (%zu)\n",
+              ranked_time, ranked_time / calls * 1e9, b);
+  std::printf("  std::multiset              : %8.3f s  %6.0f ns/call  (%zu)\n",
+              std_time, std_time / calls * 1e9, c);
+  return 0;
+}
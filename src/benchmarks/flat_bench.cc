@@ -0,0 +1,88 @@
+// Build once, read many: 1M random 8-byte keys bulk-inserted into
+// s21::flat_set, s21::set and std::set, then 10M lookups (half of them
+// misses) and a full in-order walk; the same for the map variants with
+// 8-byte mapped values.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "../s21_flat_map.h"
+#include "../s21_flat_set.h"
+#include "../s21_map.h"
+#include "../s21_set.h"
+
+namespace {
+std::vector<std::int64_t> random_keys(std::size_t n, std::uint64_t seed) {
+  std::vector<std::int64_t> keys(n);
+  for (auto& key : keys) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    key = static_cast<std::int64_t>(seed >> 1);
+  }
+  return keys;
+}
+
+template <typename Run>
+double time_of(Run run) {
+  auto start = std::chrono::steady_clock::now();
+  run();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+std::int64_t key_of(std::int64_t key) { return key; }
+
+template <typename Item>
+std::int64_t key_of(const Item& item) {
+  return item.first;
+}
+
+template <typename Set, typename Items>
+void measure(const char* name, const Items& items,
+             const std::vector<std::int64_t>& probes) {
+  Set set;
+  double build = time_of([&] { set = Set(items.begin(), items.end()); });
+  std::size_t found = 0;
+  double find = time_of([&] {
+    for (std::int64_t key : probes) found += set.find(key) != set.end();
+  });
+  std::int64_t sum = 0;
+  double walk = time_of([&] {
+    for (auto it = set.begin(); it != set.end(); ++it) sum += key_of(*it);
+  });
+  std::printf("  %-16s build %6.3f s  find %6.3f s  walk %6.4f s  "
+              "(%zu found, sum %lld)\n",
+              name, build, find, walk, found, static_cast<long long>(sum));
+}
+}  // namespace
+
+int main() {
+  const std::size_t n = 1000000;
+  const int rounds = 5;
+  std::vector<std::int64_t> keys = random_keys(n, 88172645463325252ull);
+  std::vector<std::int64_t> misses = random_keys(n, 2463534242ull);
+  std::vector<std::int64_t> probes;
+  for (int r = 0; r < rounds; ++r) {
+    probes.insert(probes.end(), keys.rbegin(), keys.rend());
+    probes.insert(probes.end(), misses.begin(), misses.end());
+  }
+  std::vector<std::pair<const std::int64_t, std::int64_t>> items;
+  for (std::int64_t key : keys) items.emplace_back(key, key / 2);
+
+  std::printf("%zu random int64 keys, %zu lookups\n", n, probes.size());
+  measure<s21::flat_set<std::int64_t>>("s21::flat_set", keys, probes);
+  measure<s21::set<std::int64_t>>("s21::set", keys, probes);
+  measure<std::set<std::int64_t>>("std::set", keys, probes);
+  measure<s21::flat_map<std::int64_t, std::int64_t>>("s21::flat_map", items,
+                                                     probes);
+  measure<s21::map<std::int64_t, std::int64_t>>("s21::map", items, probes);
+  measure<std::map<std::int64_t, std::int64_t>>("std::map", items, probes);
+  return 0;
+}
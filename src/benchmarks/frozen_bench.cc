@@ -0,0 +1,80 @@
+// Static lookup tables: 1M and 8M random 8-byte keys, then 10M successful
+// lookups in random order through s21::frozen_set, s21::flat_set, s21::set
+// and std::set, and through s21::frozen_map and s21::map. Speedups are
+// against s21::set and s21::map.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <set>
+#include <vector>
+
+#include "../s21_flat_set.h"
+#include "../s21_frozen_map.h"
+#include "../s21_frozen_set.h"
+#include "../s21_map.h"
+#include "../s21_set.h"
+
+namespace {
+std::vector<std::int64_t> random_keys(std::size_t n, std::uint64_t seed) {
+  std::vector<std::int64_t> keys(n);
+  for (auto& key : keys) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    key = static_cast<std::int64_t>(seed >> 1);
+  }
+  return keys;
+}
+
+template <typename Run>
+double time_of(Run run) {
+  auto start = std::chrono::steady_clock::now();
+  run();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+// Returns the time taken; with a baseline time it also prints the speedup.
+template <typename Set>
+double measure(const char* name, const Set& set,
+               const std::vector<std::int64_t>& probes, double baseline) {
+  std::size_t found = 0;
+  double find = time_of([&] {
+    for (std::int64_t key : probes) found += set.find(key) != set.end();
+  });
+  std::printf("  %-18s find %6.3f s  %6.1f ns/lookup", name, find,
+              find * 1e9 / probes.size());
+  if (baseline > 0) std::printf("  x%4.1f", baseline / find);
+  std::printf("  (%zu found)\n", found);
+  return find;
+}
+}  // namespace
+
+int main() {
+  const std::size_t lookups = 10000000;
+  for (std::size_t n : {1000000, 8000000}) {
+    std::vector<std::int64_t> keys = random_keys(n, 88172645463325252ull);
+    std::vector<std::int64_t> probes(lookups);
+    for (std::size_t i = 0; i < lookups; ++i)
+      probes[i] = keys[(i * 2654435761u) % n];
+
+    s21::set<std::int64_t> tree_set(keys.begin(), keys.end());
+    s21::map<std::int64_t, std::int64_t> tree_map;
+    for (std::int64_t key : keys) tree_map.insert(key, key / 2);
+    s21::frozen_set<std::int64_t> frozen_set(tree_set);
+    s21::frozen_map<std::int64_t, std::int64_t> frozen_map(tree_map);
+    s21::flat_set<std::int64_t> flat_set(keys.begin(), keys.end());
+    std::set<std::int64_t> std_set(keys.begin(), keys.end());
+
+    std::printf("%zu random int64 keys, %zu lookups\n", n, lookups);
+    double baseline = measure("s21::set", tree_set, probes, 0);
+    measure("std::set", std_set, probes, baseline);
+    measure("s21::flat_set", flat_set, probes, baseline);
+    measure("s21::frozen_set", frozen_set, probes, baseline);
+    baseline = measure("s21::map", tree_map, probes, 0);
+    measure("s21::frozen_map", frozen_map, probes, baseline);
+  }
+  return 0;
+}
@@ -0,0 +1,40 @@
+// Loading sorted keys into s21::set with and without an end() hint, next to
+// std::set with the same hint.
+
+#include <chrono>
+#include <cstdio>
+#include <set>
+
+#include "../s21_set.h"
+
+namespace {
+template <typename Set, bool Hinted>
+double load(int n) {
+  auto start = std::chrono::steady_clock::now();
+  Set set;
+  for (int key = 0; key < n; ++key) {
+    if (Hinted)
+      set.insert(set.end(), key);
+    else
+      set.insert(key);
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+}  // namespace
+
+int main() {
+  const int n = 5000000;
+  double plain = load<s21::set<int>, false>(n);
+  double hinted = load<s21::set<int>, true>(n);
+  double std_hinted = load<std::set<int>, true>(n);
+  std::printf("sorted load of %d keys\n", n);
+  std::printf("  s21::set insert(key)       : %8.3f s  %6.2f Mops/s\n", plain,
+              n / plain / 1e6);
+  std::printf("  s21::set insert(end(), key): %8.3f s  %6.2f Mops/s\n", hinted,
+              n / hinted / 1e6);
+  std::printf("  std::set insert(end(), key): %8.3f s  %6.2f Mops/s\n",
+              std_hinted, n / std_hinted / 1e6);
+  return 0;
+}
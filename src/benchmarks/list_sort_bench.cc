@@ -0,0 +1,51 @@
+// s21::list::sort against std::list::sort on the same random input. Both
+// relink nodes, so the string run shows that no values are copied.
+
+#include <chrono>
+#include <cstdio>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "../s21_list.h"
+
+namespace {
+std::vector<int> random_keys(std::size_t n) {
+  std::vector<int> keys(n);
+  unsigned seed = 12345;
+  for (auto& key : keys) {
+    seed = seed * 1103515245 + 12345;
+    key = static_cast<int>(seed >> 1);
+  }
+  return keys;
+}
+
+template <typename List, typename Make>
+double sort_time(const std::vector<int>& keys, Make make) {
+  List list;
+  for (int key : keys) list.push_back(make(key));
+  auto start = std::chrono::steady_clock::now();
+  list.sort();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+template <typename T, typename Make>
+void compare(const char* name, const std::vector<int>& keys, Make make) {
+  double s21_time = sort_time<s21::list<T>>(keys, make);
+  double std_time = sort_time<std::list<T>>(keys, make);
+  std::printf("sort of %zu %s\n", keys.size(), name);
+  std::printf("  s21::list: %8.3f s\n", s21_time);
+  std::printf("  std::list: %8.3f s\n", std_time);
+}
+}  // namespace
+
+int main() {
+  std::vector<int> keys = random_keys(1000000);
+  compare<int>("ints", keys, [](int key) { return key; });
+  compare<std::string>("strings", keys, [](int key) {
+    return std::string(32, 'x') + std::to_string(key);
+  });
+  return 0;
+}
@@ -0,0 +1,114 @@
+// Memory footprint of RBTree and ArenaTree nodes for a few key types, read
+// from the pool statistics, and insert/find/walk/copy throughput on 8-byte
+// keys where the node size matters most for the cache.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "../s21_map.h"
+#include "../s21_set.h"
+
+namespace {
+std::vector<std::int64_t> random_keys(std::size_t n) {
+  std::vector<std::int64_t> keys(n);
+  std::uint64_t seed = 88172645463325252ull;
+  for (auto& key : keys) {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    key = static_cast<std::int64_t>(seed >> 1);
+  }
+  return keys;
+}
+
+template <typename Run>
+double time_of(Run run) {
+  auto start = std::chrono::steady_clock::now();
+  run();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+// Every chunk spends one slot on its header, so a slot is the pool size
+// divided by all slots including those.
+template <typename Container>
+void footprint(const char* name, const Container& container) {
+  s21::NodePoolStats stats = container.pool_stats();
+  std::printf("  %-28s node %3zu B  %6.1f B/element\n", name,
+              stats.bytes / (stats.capacity + stats.chunks),
+              static_cast<double>(stats.bytes) / container.size());
+}
+
+template <typename Set>
+void throughput(const char* name, const std::vector<std::int64_t>& keys) {
+  const int rounds = 5;
+  Set set;
+  double insert = 0, find = 0, walk = 0, copy = 0;
+  std::size_t found = 0;
+  std::int64_t sum = 0;
+  for (int r = 0; r < rounds; ++r) {
+    set.clear();
+    insert += time_of([&] {
+      for (std::int64_t key : keys) set.insert(key);
+    });
+    find += time_of([&] {
+      for (std::int64_t key : keys) found += set.find(key) != set.end();
+    });
+    walk += time_of([&] {
+      for (std::int64_t key : set) sum += key;
+    });
+    copy += time_of([&] {
+      Set other(set);
+      found += other.size();
+    });
+  }
+  double ops = static_cast<double>(keys.size()) * rounds;
+  std::printf("  %-22s insert %5.2f  find %5.2f  walk %6.1f  copy %6.1f "
+              "Mops/s (%zu %lld)\n",
+              name, ops / insert / 1e6, ops / find / 1e6, ops / walk / 1e6,
+              ops / copy / 1e6, found, static_cast<long long>(sum));
+}
+}  // namespace
+
+int main() {
+  const std::size_t n = 1000000;
+  std::vector<std::int64_t> keys = random_keys(n);
+
+  std::printf("footprint with %zu elements\n", n);
+  s21::set<int> ints;
+  s21::set<std::int64_t> longs;
+  s21::set<std::string> strings;
+  s21::map<int, int> int_map;
+  s21::arena::set<int> arena_ints;
+  s21::arena::set<std::int64_t> arena_longs;
+  s21::arena::set<std::string> arena_strings;
+  s21::arena::map<int, int> arena_int_map;
+  for (std::int64_t key : keys) {
+    std::string text = std::to_string(key % 1000000);
+    ints.insert(static_cast<int>(key));
+    longs.insert(key);
+    strings.insert(text);
+    int_map.insert(static_cast<int>(key), 0);
+    arena_ints.insert(static_cast<int>(key));
+    arena_longs.insert(key);
+    arena_strings.insert(text);
+    arena_int_map.insert(static_cast<int>(key), 0);
+  }
+  footprint("set<int>", ints);
+  footprint("arena::set<int>", arena_ints);
+  footprint("set<int64_t>", longs);
+  footprint("arena::set<int64_t>", arena_longs);
+  footprint("set<std::string>", strings);
+  footprint("arena::set<std::string>", arena_strings);
+  footprint("map<int, int>", int_map);
+  footprint("arena::map<int, int>", arena_int_map);
+
+  std::printf("%zu random int64 keys x 5 rounds\n", n);
+  throughput<s21::set<std::int64_t>>("set<int64_t>", keys);
+  throughput<s21::arena::set<std::int64_t>>("arena::set<int64_t>", keys);
+  return 0;
+}
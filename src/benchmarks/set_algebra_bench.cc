@@ -0,0 +1,81 @@
+// Intersection and union of two s21::set<int> with the linear set
+// operations, against a find()-and-insert() loop and std::set_* writing into
+// a std::set. The last run intersects a small set with a large one.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <set>
+
+#include "../s21_set.h"
+
+namespace {
+template <typename Run>
+double time_of(Run run) {
+  auto start = std::chrono::steady_clock::now();
+  run();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+template <typename Set>
+Set multiples(int step, int n) {
+  Set set;
+  for (int i = 0; i < n; ++i) set.insert(set.end(), i * step);
+  return set;
+}
+
+void compare(int n_a, int n_b) {
+  auto a = multiples<s21::set<int>>(2, n_a);
+  auto b = multiples<s21::set<int>>(3, n_b);
+  auto std_a = multiples<std::set<int>>(2, n_a);
+  auto std_b = multiples<std::set<int>>(3, n_b);
+  std::size_t sizes[3] = {};
+
+  double linear =
+      time_of([&] { sizes[0] = s21::set_intersection(a, b).size(); });
+  double loop = time_of([&] {
+    s21::set<int> result;
+    for (int key : a)
+      if (b.contains(key)) result.insert(key);
+    sizes[1] = result.size();
+  });
+  double std_time = time_of([&] {
+    std::set<int> result;
+    std::set_intersection(std_a.begin(), std_a.end(), std_b.begin(),
+                          std_b.end(), std::inserter(result, result.end()));
+    sizes[2] = result.size();
+  });
+  std::printf("intersection of %d and %d keys (%zu %zu %zu)\n", n_a, n_b,
+              sizes[0], sizes[1], sizes[2]);
+  std::printf("  s21::set_intersection   : %9.3f ms\n", 1e3 * linear);
+  std::printf("  contains() + insert()   : %9.3f ms\n", 1e3 * loop);
+  std::printf("  std::set_intersection   : %9.3f ms\n", 1e3 * std_time);
+
+  linear = time_of([&] { sizes[0] = s21::set_union(a, b).size(); });
+  loop = time_of([&] {
+    s21::set<int> result = a;
+    for (int key : b) result.insert(key);
+    sizes[1] = result.size();
+  });
+  std_time = time_of([&] {
+    std::set<int> result;
+    std::set_union(std_a.begin(), std_a.end(), std_b.begin(), std_b.end(),
+                   std::inserter(result, result.end()));
+    sizes[2] = result.size();
+  });
+  std::printf("union of %d and %d keys (%zu %zu %zu)\n", n_a, n_b, sizes[0],
+              sizes[1], sizes[2]);
+  std::printf("  s21::set_union          : %9.3f ms\n", 1e3 * linear);
+  std::printf("  copy + insert()         : %9.3f ms\n", 1e3 * loop);
+  std::printf("  std::set_union          : %9.3f ms\n", 1e3 * std_time);
+}
+}  // namespace
+
+int main() {
+  compare(2000000, 2000000);
+  compare(1000, 4000000);
+  return 0;
+}
@@ -0,0 +1,59 @@
+// Insert/erase churn on s21::set (pooled RBTree nodes) against std::set,
+// which pays one malloc/free per node like RBTree did before the pool.
+
+#include <chrono>
+#include <cstdio>
+#include <set>
+#include <vector>
+
+#include "../s21_set.h"
+
+namespace {
+std::vector<int> random_keys(std::size_t n) {
+  std::vector<int> keys(n);
+  unsigned seed = 12345;
+  for (auto& key : keys) {
+    seed = seed * 1103515245 + 12345;
+    key = static_cast<int>(seed >> 1);
+  }
+  return keys;
+}
+
+template <typename Set>
+double churn(const std::vector<int>& keys, int rounds) {
+  auto start = std::chrono::steady_clock::now();
+  Set set;
+  for (int r = 0; r < rounds; ++r) {
+    for (int key : keys) set.insert(key);
+    for (int key : keys) {
+      auto it = set.find(key);
+      if (it != set.end()) set.erase(it);
+    }
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+}  // namespace
+
+int main() {
+  const std::size_t n = 200000;
+  const int rounds = 10;
+  std::vector<int> keys = random_keys(n);
+  double ops = 2.0 * n * rounds;
+
+  double s21_time = churn<s21::set<int>>(keys, rounds);
+  double std_time = churn<std::set<int>>(keys, rounds);
+  std::printf("insert+erase of %zu keys x %d rounds\n", n, rounds);
+  std::printf("  s21::set (node pool): %8.3f s  %6.2f Mops/s\n", s21_time,
+              ops / s21_time / 1e6);
+  std::printf("  std::set (malloc)   : %8.3f s  %6.2f Mops/s\n", std_time,
+              ops / std_time / 1e6);
+
+  s21::set<int> set;
+  for (int key : keys) set.insert(key);
+  s21::NodePoolStats stats = set.pool_stats();
+  std::printf("pool after %zu inserts: %zu chunks, %zu slots, %zu KiB\n",
+              set.size(), stats.chunks, stats.capacity, stats.bytes / 1024);
+  return 0;
+}
@@ -0,0 +1,56 @@
+// Indexed loops over s21::Vector<float> against std::vector<float>. With
+// operator[] unchecked both loops autovectorize; build with
+// -fopt-info-vec-optimized (as `make vector_access_bench` does) to see the
+// compiler report them, or add -DS21_CHECKED_ACCESS to bring the checks back.
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "../s21_vector.h"
+
+namespace {
+template <typename Vec>
+void scale(float alpha, Vec& y) {
+  for (std::size_t i = 0; i < y.size(); ++i) y[i] *= alpha;
+}
+
+template <typename Vec>
+void saxpy(float alpha, const Vec& x, Vec& y) {
+  for (std::size_t i = 0; i < x.size(); ++i) y[i] += alpha * x[i];
+}
+
+template <typename Vec>
+double run(std::size_t n, int rounds, float& checksum) {
+  Vec x(n), y(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    x[i] = static_cast<float>(i % 97) * 0.25f;
+    y[i] = 1.0f;
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; ++r) {
+    saxpy(0.5f, x, y);
+    scale(0.5f, y);
+  }
+  checksum = y[n / 3];
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+}  // namespace
+
+int main() {
+  const std::size_t n = 1 << 16;
+  const int rounds = 20000;
+  double flops = 3.0 * n * rounds;
+  float s21_y = 0, std_y = 0;
+
+  double s21_time = run<s21::Vector<float>>(n, rounds, s21_y);
+  double std_time = run<std::vector<float>>(n, rounds, std_y);
+  std::printf("saxpy + scale over %zu floats x %d rounds\n", n, rounds);
+  std::printf("  s21::Vector<float>: %8.3f s  %6.2f GFLOP/s  (y %g)\n",
+              s21_time, flops / s21_time / 1e9, s21_y);
+  std::printf("  std::vector<float>: %8.3f s  %6.2f GFLOP/s  (y %g)\n",
+              std_time, flops / std_time / 1e9, std_y);
+  return 0;
+}
@@ -0,0 +1,1045 @@
+#ifndef SRC_S21_ARENA_TREE_H_
+#define SRC_S21_ARENA_TREE_H_
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_tree.h"
+
+namespace s21 {
+// Red-black tree whose nodes live in one array and point at each other by
+// 32-bit slot numbers. A node is the key and three such links, the color
+// taking the top bit of the parent link, so small keys need half the memory
+// of an RBTree node. Links do not depend on where the array is, so growing
+// it or copying the tree moves bytes without relinking anything; for keys
+// that copy bitwise it is one memcpy.
+//
+// An iterator is a slot number and survives inserts and the array growing,
+// but it refers to the tree object, so swap and move invalidate it. A
+// reference or pointer to an element does not: growing moves every element
+// to a new array, so any insert may leave it dangling. Nodes never leave
+// the array: there are no node handles, shared pools, split, join or order
+// statistics.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>,
+          bool OrderStatistics = false>
+class ArenaTree : private CompareStorage<Compare> {
+  static_assert(!OrderStatistics, "ArenaTree keeps no subtree sizes");
+
+  struct Node;
+  class ArenaTreeIterator;
+  class ArenaTreeConstIterator;
+
+  using reference = Key&;
+  using const_reference = const Key&;
+  using size_type = std::size_t;
+  using index_type = std::uint32_t;
+  using compare_storage = CompareStorage<Compare>;
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using node_allocator = typename alloc_traits::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
+
+  enum NodeColor : index_type { BL = 0, RD = index_type{1} << 31 };
+  static constexpr index_type kColorMask = RD;
+  // Slot 0 never holds a node: as a link it means none, as a position end().
+  static constexpr index_type kNil = 0;
+  // Parent link of a slot without a value.
+  static constexpr index_type kFree = ~index_type{0};
+  static constexpr index_type kMaxSlots = kColorMask - 1;
+  static constexpr index_type kFirstCapacity = 16;
+  // Keys that can be copied as bytes, so the array can be too.
+  static constexpr bool kBitwise =
+      std::is_trivially_copy_constructible<Key>::value &&
+      std::is_trivially_destructible<Key>::value;
+
+ public:
+  using value_type = Key;
+  using key_compare = Compare;
+  using iterator = ArenaTreeIterator;
+  using const_iterator = ArenaTreeConstIterator;
+  using allocator_type = Allocator;
+
+  // Stand-ins that keep the node-based declarations of set and map valid.
+  // Nothing that uses them compiles with an ArenaTree.
+  struct NoNodes {};
+  using node_pool = NoNodes;
+  using node_type = NoNodes;
+  using insert_return_type = NoNodes;
+
+  ArenaTree() : ArenaTree(Compare()){};
+
+  explicit ArenaTree(const Compare& comp, const Allocator& alloc = Allocator())
+      : compare_storage(comp), alloc_(alloc){};
+
+  ArenaTree(const ArenaTree& other)
+      : ArenaTree(other.key_comp(),
+                  alloc_traits::select_on_container_copy_construction(
+                      other.alloc_)) {
+    *this = other;
+  };
+
+  ArenaTree(const ArenaTree& other, const Allocator& alloc)
+      : ArenaTree(other.key_comp(), alloc) {
+    *this = other;
+  };
+
+  ArenaTree(ArenaTree&& other) : ArenaTree(other.key_comp(), other.alloc_) {
+    swap(other);
+  };
+
+  ~ArenaTree() { release(); };
+
+  ArenaTree& operator=(const ArenaTree& other) {
+    if (this != &other) {
+      release();
+      compare_storage::operator=(other);
+      if (other.size_ != 0) copy_nodes(other);
+    }
+    return *this;
+  };
+
+  // Like RBTree, memory of an unequal, non-propagating allocator is not
+  // taken over: the elements are copied instead.
+  ArenaTree& operator=(ArenaTree&& other) {
+    if (this != &other &&
+        !alloc_traits::propagate_on_container_move_assignment::value &&
+        alloc_ != other.alloc_) {
+      *this = other;
+      other.clear();
+    } else if (this != &other) {
+      release();
+      swap(other);
+    }
+    return *this;
+  };
+
+  iterator begin() noexcept { return iterator(this, leftmost_); };
+
+  const_iterator begin() const noexcept {
+    return const_cast<ArenaTree*>(this)->begin();
+  };
+
+  iterator end() noexcept { return iterator(this, kNil); };
+
+  const_iterator end() const noexcept {
+    return const_cast<ArenaTree*>(this)->end();
+  };
+
+  key_compare key_comp() const { return compare_storage::get(); };
+
+  allocator_type get_allocator() const noexcept { return alloc_; };
+
+  bool empty() const noexcept { return size_ == 0; };
+
+  size_type size() const noexcept { return size_; };
+
+  size_type max_size() const noexcept {
+    size_type slots = node_traits::max_size(node_allocator(alloc_));
+    return (slots < kMaxSlots ? slots : kMaxSlots) - 1;
+  };
+
+  // The array as a pool of one chunk whose first slot is reserved.
+  NodePoolStats pool_stats() const noexcept {
+    if (nodes_ == nullptr) return NodePoolStats{};
+    return NodePoolStats{1, capacity_ - size_type{1}, size_,
+                         used_ - size_type{1} - size_,
+                         capacity_ * sizeof(Node)};
+  };
+
+  // Destroys the elements and keeps the array for the next ones.
+  void clear() noexcept {
+    if (nodes_ == nullptr) return;
+    destroy_values(nodes_, used_);
+    used_ = 1;
+    free_ = root_ = leftmost_ = rightmost_ = kNil;
+    size_ = 0;
+  };
+
+  void swap(ArenaTree& other) noexcept {
+    compare_storage::swap(other);
+    if (alloc_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_, other.alloc_);
+    }
+    std::swap(nodes_, other.nodes_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(used_, other.used_);
+    std::swap(free_, other.free_);
+    std::swap(root_, other.root_);
+    std::swap(leftmost_, other.leftmost_);
+    std::swap(rightmost_, other.rightmost_);
+    std::swap(size_, other.size_);
+  };
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return insert_value(value);
+  };
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return insert_value(std::move(value));
+  };
+
+  iterator insert(const_iterator hint, const value_type& value) {
+    return emplace_hint(hint, value);
+  };
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    index_type node = create_node(std::forward<Args>(args)...);
+    Position pos = position_or_destroy(node);
+    if (pos.equal != kNil) return {iterator(this, pos.equal), false};
+    link_node(node, pos.parent, pos.to_left);
+    return {iterator(this, node), true};
+  };
+
+  // A hint at the element right after the new one links it without a
+  // descent, as in RBTree.
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    index_type node = create_node(std::forward<Args>(args)...);
+    index_type next = hint.it_.index_;
+    index_type prev = next == leftmost_ ? kNil : predecessor(next);
+    if ((next == kNil || compare(value(node), value(next))) &&
+        (prev == kNil || compare(value(prev), value(node)))) {
+      if (prev != kNil && right(prev) == kNil)
+        link_node(node, prev, false);
+      else
+        link_node(node, next, true);
+      return iterator(this, node);
+    }
+    Position pos = position_or_destroy(node);
+    if (pos.equal != kNil) return iterator(this, pos.equal);
+    link_node(node, pos.parent, pos.to_left);
+    return iterator(this, node);
+  };
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    std::vector<std::pair<iterator, bool>> vect;
+    vect.reserve(sizeof...(args));
+    (vect.push_back(emplace(std::forward<Args>(args))), ...);
+    return vect;
+  };
+
+  // Replaces the contents with [first, last). While the range is sorted the
+  // values fill the array in order and are linked into a perfectly balanced
+  // tree in O(n), so an in-order walk reads the array front to back; the
+  // first value out of order and everything after it are inserted one by
+  // one.
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    clear();
+    size_type n = std::distance(first, last);
+    if (n == 0) return;
+    reserve(n);
+    index_type built = 0;
+    try {
+      for (; first != last; ++first) {
+        index_type node = create_node(*first);
+        if (built != 0) {
+          bool before = compare(value(node), value(node - 1));
+          if (before || !compare(value(node - 1), value(node))) {
+            alloc_traits::destroy(alloc_, &value(node));
+            --used_;
+            if (before) break;
+            continue;
+          }
+        }
+        ++built;
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+    link_sorted(built);
+    for (; first != last; ++first) insert(*first);
+  };
+
+  void erase(iterator pos) {
+    if (pos.index_ == kNil) return;
+    unlink(pos.index_);
+    destroy_node(pos.index_);
+    size_--;
+  };
+
+  // Elements of other that we lack are moved over; erasing them there
+  // relinks nodes without moving any, so the walk over other can go on.
+  void merge(ArenaTree& other) {
+    if (this == &other) return;
+    for (index_type node = other.leftmost_; node != kNil;) {
+      index_type next = other.successor(node);
+      Position pos = find_position(other.value(node));
+      if (pos.equal == kNil) {
+        link_node(create_node(std::move(other.value(node))), pos.parent,
+                  pos.to_left);
+        other.erase(iterator(&other, node));
+      }
+      node = next;
+    }
+  };
+
+  // Set algebra in one walk over both trees. The result is built in order
+  // straight into a fresh array, like assign_sorted().
+  static ArenaTree combine(const ArenaTree& a, const ArenaTree& b,
+                           SetOperation op) {
+    bool only_a = op != SetOperation::kIntersection;
+    bool only_b =
+        op == SetOperation::kUnion || op == SetOperation::kSymmetricDifference;
+    bool both =
+        op == SetOperation::kUnion || op == SetOperation::kIntersection;
+    ArenaTree result(a.key_comp(), a.alloc_);
+    size_type bound = (only_a ? a.size_ : 0) + (only_b ? b.size_ : 0);
+    if (!only_a) bound = a.size_ < b.size_ ? a.size_ : b.size_;
+    if (bound == 0) return result;
+    result.reserve(bound);
+    index_type built = 0;
+    auto take = [&result, &built](const Key& value) {
+      result.create_node(value);
+      ++built;
+    };
+    index_type i = a.leftmost_, j = b.leftmost_;
+    while (i != kNil && j != kNil) {
+      if (a.compare(a.value(i), b.value(j))) {
+        if (only_a) take(a.value(i));
+        i = a.successor(i);
+      } else if (a.compare(b.value(j), a.value(i))) {
+        if (only_b) take(b.value(j));
+        j = b.successor(j);
+      } else {
+        if (both) take(a.value(i));
+        i = a.successor(i);
+        j = b.successor(j);
+      }
+    }
+    for (; only_a && i != kNil; i = a.successor(i)) take(a.value(i));
+    for (; only_b && j != kNil; j = b.successor(j)) take(b.value(j));
+    result.link_sorted(built);
+    return result;
+  };
+
+  template <typename K = Key>
+  iterator find(const key_arg<K>& key) noexcept {
+    index_type node = lower_bound_index(key);
+    if (node == kNil || compare(key, value(node))) return end();
+    return iterator(this, node);
+  };
+
+  template <typename K = Key>
+  const_iterator find(const key_arg<K>& key) const noexcept {
+    return const_cast<ArenaTree*>(this)->template find<K>(key);
+  };
+
+  template <typename K = Key>
+  bool contains(const key_arg<K>& key) const noexcept {
+    return find<K>(key) != end();
+  };
+
+  template <typename K = Key>
+  size_type count(const key_arg<K>& key) const noexcept {
+    return contains<K>(key) ? 1 : 0;
+  };
+
+  template <typename K = Key>
+  iterator lower_bound(const key_arg<K>& key) noexcept {
+    return iterator(this, lower_bound_index(key));
+  };
+
+  template <typename K = Key>
+  const_iterator lower_bound(const key_arg<K>& key) const noexcept {
+    return const_cast<ArenaTree*>(this)->template lower_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  iterator upper_bound(const key_arg<K>& key) noexcept {
+    index_type node = root_, bound = kNil;
+    while (node != kNil) {
+      if (compare(key, value(node))) {
+        bound = node;
+        node = left(node);
+      } else {
+        node = right(node);
+      }
+    }
+    return iterator(this, bound);
+  };
+
+  template <typename K = Key>
+  const_iterator upper_bound(const key_arg<K>& key) const noexcept {
+    return const_cast<ArenaTree*>(this)->template upper_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  std::pair<iterator, iterator> equal_range(const key_arg<K>& key) noexcept {
+    return {lower_bound<K>(key), upper_bound<K>(key)};
+  };
+
+  template <typename K = Key>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_arg<K>& key) const noexcept {
+    return {lower_bound<K>(key), upper_bound<K>(key)};
+  };
+
+ private:
+  template <typename A, typename B>
+  bool compare(const A& a, const B& b) const {
+    return compare_storage::get()(a, b);
+  };
+
+  struct Node {
+    alignas(Key) unsigned char storage_[sizeof(Key)];
+    index_type parent_color_;
+    index_type left_;
+    index_type right_;
+
+    Key& value() noexcept {
+      return *std::launder(reinterpret_cast<Key*>(storage_));
+    };
+  };
+
+  // Where a key goes: under parent on the given side, unless an equal
+  // element is already there.
+  struct Position {
+    index_type parent;
+    bool to_left;
+    index_type equal;
+  };
+
+  Key& value(index_type node) const noexcept {
+    return nodes_[node].value();
+  };
+
+  index_type& left(index_type node) const noexcept {
+    return nodes_[node].left_;
+  };
+
+  index_type& right(index_type node) const noexcept {
+    return nodes_[node].right_;
+  };
+
+  index_type parent(index_type node) const noexcept {
+    return nodes_[node].parent_color_ & ~kColorMask;
+  };
+
+  NodeColor color(index_type node) const noexcept {
+    return static_cast<NodeColor>(nodes_[node].parent_color_ & kColorMask);
+  };
+
+  bool red(index_type node) const noexcept {
+    return node != kNil && color(node) == RD;
+  };
+
+  void set_parent(index_type node, index_type parent) noexcept {
+    index_type& link = nodes_[node].parent_color_;
+    link = parent | (link & kColorMask);
+  };
+
+  void set_color(index_type node, NodeColor color) noexcept {
+    index_type& link = nodes_[node].parent_color_;
+    link = (link & ~kColorMask) | color;
+  };
+
+  index_type minimum(index_type node) const noexcept {
+    while (left(node) != kNil) node = left(node);
+    return node;
+  };
+
+  index_type maximum(index_type node) const noexcept {
+    while (right(node) != kNil) node = right(node);
+    return node;
+  };
+
+  index_type successor(index_type node) const noexcept {
+    if (right(node) != kNil) return minimum(right(node));
+    index_type up = parent(node);
+    while (up != kNil && node == right(up)) {
+      node = up;
+      up = parent(up);
+    }
+    return up;
+  };
+
+  index_type predecessor(index_type node) const noexcept {
+    if (node == kNil) return rightmost_;
+    if (left(node) != kNil) return maximum(left(node));
+    index_type up = parent(node);
+    while (up != kNil && node == left(up)) {
+      node = up;
+      up = parent(up);
+    }
+    return up;
+  };
+
+  template <typename K>
+  index_type lower_bound_index(const K& key) const noexcept {
+    index_type node = root_, bound = kNil;
+    while (node != kNil) {
+      if (!compare(value(node), key)) {
+        bound = node;
+        node = left(node);
+      } else {
+        node = right(node);
+      }
+    }
+    return bound;
+  };
+
+  template <typename K>
+  Position find_position(const K& key) const {
+    index_type node = root_, parent = kNil;
+    bool to_left = true;
+    while (node != kNil) {
+      parent = node;
+      to_left = compare(key, value(node));
+      node = to_left ? left(node) : right(node);
+    }
+    index_type prev = parent;
+    if (to_left) {
+      if (parent == leftmost_) return {parent, true, kNil};
+      prev = predecessor(parent);
+    }
+    if (compare(value(prev), key)) return {parent, to_left, kNil};
+    return {parent, to_left, prev};
+  };
+
+  // find_position() for a node already holding its value, which is given
+  // back when the value is a duplicate or the comparison throws.
+  Position position_or_destroy(index_type node) {
+    Position pos{};
+    try {
+      pos = find_position(value(node));
+    } catch (...) {
+      destroy_node(node);
+      throw;
+    }
+    if (pos.equal != kNil) destroy_node(node);
+    return pos;
+  };
+
+  template <typename V>
+  std::pair<iterator, bool> insert_value(V&& value) {
+    Position pos = find_position(value);
+    if (pos.equal != kNil) return {iterator(this, pos.equal), false};
+    index_type node = create_node(std::forward<V>(value));
+    link_node(node, pos.parent, pos.to_left);
+    return {iterator(this, node), true};
+  };
+
+  // Constructs a value in a free slot, growing the array when there is
+  // none. The node is not linked yet.
+  template <typename... Args>
+  index_type create_node(Args&&... args) {
+    index_type node = free_;
+    if (node != kNil) {
+      construct_value(nodes_, node, std::forward<Args>(args)...);
+      free_ = left(node);
+    } else if (used_ != 0 && used_ < capacity_) {
+      node = used_;
+      construct_value(nodes_, node, std::forward<Args>(args)...);
+      ++used_;
+    } else {
+      node = grow(std::forward<Args>(args)...);
+    }
+    nodes_[node].parent_color_ = RD;
+    left(node) = right(node) = kNil;
+    return node;
+  };
+
+  template <typename... Args>
+  void construct_value(Node* nodes, index_type node, Args&&... args) {
+    alloc_traits::construct(alloc_, &nodes[node].value(),
+                            std::forward<Args>(args)...);
+  };
+
+  // Takes back a slot whose node is already unlinked.
+  void destroy_node(index_type node) noexcept {
+    alloc_traits::destroy(alloc_, &value(node));
+    nodes_[node].parent_color_ = kFree;
+    left(node) = free_;
+    free_ = node;
+  };
+
+  void destroy_values(Node* nodes, index_type used) noexcept {
+    if (std::is_trivially_destructible<Key>::value) return;
+    for (index_type i = 1; i < used; ++i) {
+      if (nodes[i].parent_color_ != kFree)
+        alloc_traits::destroy(alloc_, &nodes[i].value());
+    }
+  };
+
+  Node* allocate_nodes(index_type capacity) {
+    node_allocator alloc(alloc_);
+    Node* nodes = node_traits::allocate(alloc, capacity);
+    nodes[0].parent_color_ = kFree;
+    nodes[0].left_ = nodes[0].right_ = kNil;
+    return nodes;
+  };
+
+  void deallocate_nodes(Node* nodes, index_type capacity) noexcept {
+    node_allocator alloc(alloc_);
+    node_traits::deallocate(alloc, nodes, capacity);
+  };
+
+  // Doubles the array. The new value is constructed first, since args may
+  // refer to an element in the old array.
+  template <typename... Args>
+  index_type grow(Args&&... args) {
+    if (capacity_ >= kMaxSlots) throw std::length_error("ArenaTree is full");
+    index_type capacity = capacity_ == 0           ? kFirstCapacity
+                          : capacity_ > kMaxSlots / 2 ? kMaxSlots
+                                                      : capacity_ * 2;
+    Node* nodes = allocate_nodes(capacity);
+    index_type node = used_ == 0 ? 1 : used_;
+    try {
+      construct_value(nodes, node, std::forward<Args>(args)...);
+    } catch (...) {
+      deallocate_nodes(nodes, capacity);
+      throw;
+    }
+    try {
+      move_nodes(nodes);
+    } catch (...) {
+      alloc_traits::destroy(alloc_, &nodes[node].value());
+      deallocate_nodes(nodes, capacity);
+      throw;
+    }
+    nodes_ = nodes;
+    capacity_ = capacity;
+    used_ = node + 1;
+    return node;
+  };
+
+  // Makes room for n elements in total.
+  void reserve(size_type n) {
+    if (n + 1 <= capacity_) return;
+    if (n >= kMaxSlots) throw std::length_error("ArenaTree is full");
+    index_type capacity = static_cast<index_type>(n + 1);
+    Node* nodes = allocate_nodes(capacity);
+    try {
+      move_nodes(nodes);
+    } catch (...) {
+      deallocate_nodes(nodes, capacity);
+      throw;
+    }
+    if (used_ == 0) used_ = 1;
+    nodes_ = nodes;
+    capacity_ = capacity;
+  };
+
+  // Moves the used slots into nodes and frees the old array; slot numbers,
+  // and with them all links, stay as they are.
+  void move_nodes(Node* nodes) {
+    if (nodes_ == nullptr) return;
+    if constexpr (kBitwise) {
+      std::memcpy(static_cast<void*>(nodes), nodes_, used_ * sizeof(Node));
+    } else {
+      index_type i = 1;
+      try {
+        for (; i < used_; ++i) {
+          nodes[i].parent_color_ = nodes_[i].parent_color_;
+          nodes[i].left_ = nodes_[i].left_;
+          nodes[i].right_ = nodes_[i].right_;
+          if (nodes_[i].parent_color_ != kFree)
+            construct_value(nodes, i, std::move_if_noexcept(value(i)));
+        }
+      } catch (...) {
+        destroy_values(nodes, i);
+        throw;
+      }
+      destroy_values(nodes_, used_);
+    }
+    deallocate_nodes(nodes_, capacity_);
+  };
+
+  // A copy keeps the slot numbers of other, free slots included.
+  void copy_nodes(const ArenaTree& other) {
+    Node* nodes = allocate_nodes(other.used_);
+    if constexpr (kBitwise) {
+      std::memcpy(static_cast<void*>(nodes), other.nodes_,
+                  other.used_ * sizeof(Node));
+    } else {
+      index_type i = 1;
+      try {
+        for (; i < other.used_; ++i) {
+          nodes[i].parent_color_ = other.nodes_[i].parent_color_;
+          nodes[i].left_ = other.nodes_[i].left_;
+          nodes[i].right_ = other.nodes_[i].right_;
+          if (nodes[i].parent_color_ != kFree)
+            construct_value(nodes, i, other.value(i));
+        }
+      } catch (...) {
+        destroy_values(nodes, i);
+        deallocate_nodes(nodes, other.used_);
+        throw;
+      }
+    }
+    nodes_ = nodes;
+    capacity_ = used_ = other.used_;
+    free_ = other.free_;
+    root_ = other.root_;
+    leftmost_ = other.leftmost_;
+    rightmost_ = other.rightmost_;
+    size_ = other.size_;
+  };
+
+  void release() noexcept {
+    if (nodes_ == nullptr) return;
+    clear();
+    deallocate_nodes(nodes_, capacity_);
+    nodes_ = nullptr;
+    capacity_ = used_ = 0;
+  };
+
+  // Links the n nodes in slots 1..n, which hold ascending values. The
+  // deepest level of the balanced shape is red and everything above black.
+  void link_sorted(index_type n) noexcept {
+    size_ = n;
+    if (n == 0) return;
+    int red_depth = 0;
+    while ((size_type{2} << red_depth) <= n) ++red_depth;
+    root_ = build(1, n, kNil, 0, red_depth);
+    set_color(root_, BL);
+    leftmost_ = 1;
+    rightmost_ = n;
+  };
+
+  index_type build(index_type lo, index_type hi, index_type parent, int depth,
+                   int red_depth) noexcept {
+    if (lo > hi) return kNil;
+    index_type mid = lo + (hi - lo) / 2;
+    nodes_[mid].parent_color_ = parent | (depth == red_depth ? RD : BL);
+    left(mid) = build(lo, mid - 1, mid, depth + 1, red_depth);
+    right(mid) = build(mid + 1, hi, mid, depth + 1, red_depth);
+    return mid;
+  };
+
+  // Hangs a red node under parent (kNil for an empty tree) and rebalances.
+  void link_node(index_type node, index_type parent, bool to_left) noexcept {
+    set_parent(node, parent);
+    if (parent == kNil) {
+      root_ = leftmost_ = rightmost_ = node;
+    } else if (to_left) {
+      left(parent) = node;
+      if (parent == leftmost_) leftmost_ = node;
+    } else {
+      right(parent) = node;
+      if (parent == rightmost_) rightmost_ = node;
+    }
+    ++size_;
+    balance_insert(node);
+  };
+
+  void rotate_left(index_type node) noexcept {
+    index_type child = right(node);
+    right(node) = left(child);
+    if (left(child) != kNil) set_parent(left(child), node);
+    replace_child(node, child);
+    set_parent(child, parent(node));
+    left(child) = node;
+    set_parent(node, child);
+  };
+
+  void rotate_right(index_type node) noexcept {
+    index_type child = left(node);
+    left(node) = right(child);
+    if (right(child) != kNil) set_parent(right(child), node);
+    replace_child(node, child);
+    set_parent(child, parent(node));
+    right(child) = node;
+    set_parent(node, child);
+  };
+
+  // Points the link that leads to node at other instead.
+  void replace_child(index_type node, index_type other) noexcept {
+    index_type up = parent(node);
+    if (node == root_)
+      root_ = other;
+    else if (node == left(up))
+      left(up) = other;
+    else
+      right(up) = other;
+  };
+
+  void balance_insert(index_type node) noexcept {
+    while (node != root_ && color(parent(node)) == RD) {
+      index_type up = parent(node);
+      index_type grand = parent(up);
+      if (up == left(grand)) {
+        index_type uncle = right(grand);
+        if (red(uncle)) {
+          set_color(up, BL);
+          set_color(uncle, BL);
+          set_color(grand, RD);
+          node = grand;
+          continue;
+        }
+        if (node == right(up)) {
+          node = up;
+          rotate_left(node);
+          up = parent(node);
+        }
+        set_color(up, BL);
+        set_color(grand, RD);
+        rotate_right(grand);
+      } else {
+        index_type uncle = left(grand);
+        if (red(uncle)) {
+          set_color(up, BL);
+          set_color(uncle, BL);
+          set_color(grand, RD);
+          node = grand;
+          continue;
+        }
+        if (node == left(up)) {
+          node = up;
+          rotate_right(node);
+          up = parent(node);
+        }
+        set_color(up, BL);
+        set_color(grand, RD);
+        rotate_left(grand);
+      }
+    }
+    set_color(root_, BL);
+  };
+
+  // Takes node out of the tree. A node with two children trades places with
+  // its successor, so every other node keeps its slot and its links stay
+  // valid for an ongoing walk.
+  void unlink(index_type node) noexcept {
+    index_type out = node;
+    index_type child = kNil;
+    index_type child_parent = kNil;
+    if (left(out) == kNil) {
+      child = right(out);
+    } else if (right(out) == kNil) {
+      child = left(out);
+    } else {
+      out = minimum(right(out));
+      child = right(out);
+    }
+    if (out != node) {
+      set_parent(left(node), out);
+      left(out) = left(node);
+      if (out != right(node)) {
+        child_parent = parent(out);
+        if (child != kNil) set_parent(child, child_parent);
+        left(child_parent) = child;
+        right(out) = right(node);
+        set_parent(right(node), out);
+      } else {
+        child_parent = out;
+      }
+      replace_child(node, out);
+      set_parent(out, parent(node));
+      NodeColor out_color = color(out);
+      set_color(out, color(node));
+      set_color(node, out_color);
+    } else {
+      child_parent = parent(node);
+      if (child != kNil) set_parent(child, child_parent);
+      replace_child(node, child);
+      if (leftmost_ == node)
+        leftmost_ = child == kNil ? child_parent : minimum(child);
+      if (rightmost_ == node)
+        rightmost_ = child == kNil ? child_parent : maximum(child);
+    }
+    if (color(node) == BL) balance_erase(child, child_parent);
+  };
+
+  // Restores the black height after a black node above child was removed.
+  void balance_erase(index_type child, index_type up) noexcept {
+    while (child != root_ && !red(child)) {
+      if (child == left(up)) {
+        index_type sibling = right(up);
+        if (red(sibling)) {
+          set_color(sibling, BL);
+          set_color(up, RD);
+          rotate_left(up);
+          sibling = right(up);
+        }
+        if (!red(left(sibling)) && !red(right(sibling))) {
+          set_color(sibling, RD);
+          child = up;
+          up = parent(up);
+          continue;
+        }
+        if (!red(right(sibling))) {
+          set_color(left(sibling), BL);
+          set_color(sibling, RD);
+          rotate_right(sibling);
+          sibling = right(up);
+        }
+        set_color(sibling, color(up));
+        set_color(up, BL);
+        set_color(right(sibling), BL);
+        rotate_left(up);
+      } else {
+        index_type sibling = left(up);
+        if (red(sibling)) {
+          set_color(sibling, BL);
+          set_color(up, RD);
+          rotate_right(up);
+          sibling = left(up);
+        }
+        if (!red(left(sibling)) && !red(right(sibling))) {
+          set_color(sibling, RD);
+          child = up;
+          up = parent(up);
+          continue;
+        }
+        if (!red(left(sibling))) {
+          set_color(right(sibling), BL);
+          set_color(sibling, RD);
+          rotate_left(sibling);
+          sibling = left(up);
+        }
+        set_color(sibling, color(up));
+        set_color(up, BL);
+        set_color(left(sibling), BL);
+        rotate_right(up);
+      }
+      break;
+    }
+    if (child != kNil) set_color(child, BL);
+  };
+
+  class ArenaTreeIterator {
+    friend ArenaTree;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Key*;
+    using reference = Key&;
+
+    ArenaTreeIterator() = default;
+
+    reference operator*() const noexcept { return tree_->value(index_); };
+
+    pointer operator->() const noexcept { return &tree_->value(index_); };
+
+    bool operator==(const iterator& other) const noexcept {
+      return tree_ == other.tree_ && index_ == other.index_;
+    };
+
+    bool operator!=(const iterator& other) const noexcept {
+      return !(*this == other);
+    };
+
+    iterator& operator++() noexcept {
+      index_ = tree_->successor(index_);
+      return *this;
+    };
+
+    iterator operator++(int) noexcept {
+      iterator temp(*this);
+      ++(*this);
+      return temp;
+    };
+
+    iterator& operator--() noexcept {
+      index_ = tree_->predecessor(index_);
+      return *this;
+    };
+
+    iterator operator--(int) noexcept {
+      iterator temp(*this);
+      --(*this);
+      return temp;
+    };
+
+   private:
+    ArenaTreeIterator(const ArenaTree* tree, index_type index)
+        : tree_(tree), index_(index){};
+
+    const ArenaTree* tree_ = nullptr;
+    index_type index_ = kNil;
+  };
+
+  class ArenaTreeConstIterator {
+    friend ArenaTree;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
+    ArenaTreeConstIterator() = default;
+    ArenaTreeConstIterator(const iterator& other) : it_(other){};
+
+    reference operator*() const noexcept { return *it_; };
+
+    pointer operator->() const noexcept { return &*it_; };
+
+    const_iterator& operator++() noexcept {
+      ++it_;
+      return *this;
+    };
+
+    const_iterator operator++(int) noexcept {
+      const_iterator temp(*this);
+      ++it_;
+      return temp;
+    };
+
+    const_iterator& operator--() noexcept {
+      --it_;
+      return *this;
+    };
+
+    const_iterator operator--(int) noexcept {
+      const_iterator temp(*this);
+      --it_;
+      return temp;
+    };
+
+    friend bool operator==(const const_iterator& it1,
+                           const const_iterator& it2) noexcept {
+      return it1.it_ == it2.it_;
+    };
+
+    friend bool operator!=(const const_iterator& it1,
+                           const const_iterator& it2) noexcept {
+      return it1.it_ != it2.it_;
+    };
+
+   private:
+    iterator it_;
+  };
+
+  Node* nodes_ = nullptr;
+  index_type capacity_ = 0;
+  index_type used_ = 0;     // slots below this have held a value
+  index_type free_ = kNil;  // slots given back, linked through left_
+  index_type root_ = kNil;
+  index_type leftmost_ = kNil;
+  index_type rightmost_ = kNil;
+  size_type size_ = 0;
+  Allocator alloc_;
+};
+
+// Keeps the elements of a set or map in an ArenaTree.
+struct ArenaStorage {
+  template <typename Key, typename Compare, typename Allocator,
+            bool OrderStatistics>
+  using tree = ArenaTree<Key, Compare, Allocator, OrderStatistics>;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_ARENA_TREE_H_
@@ -1,10 +1,14 @@
 #ifndef SRC_S21_ARRAY_H_
 #define SRC_S21_ARRAY_H_
 
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
 #include <iterator>
 #include <limits>
+#include <type_traits>
 #include <vector>
 
 namespace s21 {
@@ -29,14 +33,10 @@ class Array {
       arr_[i++] = elem;
     }
   }
-  Array(const Array &a) noexcept : Array() {
-    for (size_t i = 0; i < size_; i++) {
-      arr_[i] = a.arr_[i];
-    }
-  }
+  Array(const Array &a) noexcept : Array() { copy_from(a.arr_); }
   Array(Array &&a) noexcept : Array() {
     if (this != &a) {
-      std::move(a.cbegin(), a.cend(), arr_);
+      move_from(a.arr_);
     }
   }
 
@@ -45,7 +45,7 @@ class Array {
   Array operator=(Array &&a) {
     this->fill(0);
     if (this != &a) {
-      std::move(a.cbegin(), a.cend(), arr_);
+      move_from(a.arr_);
     }
 
     return *this;
@@ -53,9 +53,7 @@ class Array {
 
   Array operator=(Array &a) {
     this->fill(0);
-    for (size_t i = 0; i < size_; i++) {
-      arr_[i] = a.arr_[i];
-    }
+    copy_from(a.arr_);
 
     return *this;
   }
@@ -76,9 +74,17 @@ class Array {
   }
 
   reference operator[](size_type pos) {
-    return at(pos);
-  }  // access specified element
-  const_reference operator[](size_type pos) const { return at(pos); }
+#ifdef S21_CHECKED_ACCESS
+    assert(pos < size_ && "Array index out of range");
+#endif
+    return arr_[pos];
+  }  // access specified element without bounds checking
+  const_reference operator[](size_type pos) const {
+#ifdef S21_CHECKED_ACCESS
+    assert(pos < size_ && "Array index out of range");
+#endif
+    return arr_[pos];
+  }
 
   const_reference front() const { return arr_[0]; }  // access the first element
   const_reference back() const {
@@ -120,6 +126,23 @@ class Array {
   }  // assigns the given value value to all elements in the container.
 
  private:
+  // trivially copyable elements are copied as one block of bytes
+  void copy_from(const value_type *src) {
+    if constexpr (std::is_trivially_copyable<value_type>::value) {
+      std::memcpy(arr_, src, sizeof(arr_));
+    } else {
+      std::copy(src, src + N, arr_);
+    }
+  }
+
+  void move_from(value_type *src) {
+    if constexpr (std::is_trivially_copyable<value_type>::value) {
+      std::memcpy(arr_, src, sizeof(arr_));
+    } else {
+      std::move(src, src + N, arr_);
+    }
+  }
+
   size_type size_;
   value_type arr_[N];
 };
@@ -0,0 +1,852 @@
+#ifndef SRC_S21_BTREE_H_
+#define SRC_S21_BTREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_compare.h"
+
+namespace s21 {
+// Ordered storage in nodes of many values each. A node is sized to a few
+// cache lines, so one step of a descent touches one or two lines where a
+// binary tree spends a miss per level, and an in-order walk mostly reads
+// consecutive memory. Leaves hold values only; internal nodes also hold
+// count + 1 children. Inserting and erasing move values between slots, so
+// unlike RBTree every modification invalidates all iterators.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class BTree : private CompareStorage<Compare> {
+  struct Node;
+  struct InternalNode;
+  class BTreeIterator;
+  class BTreeConstIterator;
+
+  using reference = Key&;
+  using const_reference = const Key&;
+  using size_type = std::size_t;
+  using compare_storage = CompareStorage<Compare>;
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using leaf_allocator = typename alloc_traits::template rebind_alloc<Node>;
+  using leaf_traits = std::allocator_traits<leaf_allocator>;
+  using internal_allocator =
+      typename alloc_traits::template rebind_alloc<InternalNode>;
+  using internal_traits = std::allocator_traits<internal_allocator>;
+
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
+
+  // Values per node: as many as fit in kTargetNodeBytes next to the header,
+  // but at least three so that a split always leaves both halves non-empty.
+  static constexpr size_type kTargetNodeBytes = 256;
+  static constexpr size_type kHeaderBytes = sizeof(void*) + 8;
+  static constexpr size_type kSlots =
+      (kTargetNodeBytes - kHeaderBytes) / sizeof(Key) < 3
+          ? 3
+          : (kTargetNodeBytes - kHeaderBytes) / sizeof(Key);
+  // A node below this many values after an erase borrows from a sibling or
+  // is merged with one; two such nodes and their separator always fit.
+  static constexpr size_type kMinValues = (kSlots - 1) / 2;
+
+  static_assert(kSlots <= std::numeric_limits<std::uint16_t>::max(),
+                "node counts are kept in 16 bits");
+
+ public:
+  using value_type = Key;
+  using key_compare = Compare;
+  using iterator = BTreeIterator;
+  using const_iterator = BTreeConstIterator;
+  using allocator_type = Allocator;
+
+  BTree() : BTree(Compare()){};
+
+  explicit BTree(const Compare& comp, const Allocator& alloc = Allocator())
+      : compare_storage(comp), alloc_(alloc){};
+
+  BTree(const BTree& other)
+      : BTree(other.key_comp(),
+              alloc_traits::select_on_container_copy_construction(
+                  other.alloc_)) {
+    *this = other;
+  };
+
+  BTree(const BTree& other, const Allocator& alloc)
+      : BTree(other.key_comp(), alloc) {
+    *this = other;
+  };
+
+  BTree(BTree&& other) : BTree(other.key_comp(), other.alloc_) {
+    swap(other);
+  };
+
+  ~BTree() { clear(); };
+
+  BTree& operator=(const BTree& other) {
+    if (this != &other) {
+      clear();
+      compare_storage::operator=(other);
+      if (other.root_) root_ = copy(other.root_, nullptr);
+      size_ = other.size_;
+    }
+    return *this;
+  };
+
+  // Like RBTree, memory of an unequal, non-propagating allocator is not
+  // taken over: the elements are copied instead.
+  BTree& operator=(BTree&& other) {
+    if (this != &other &&
+        !alloc_traits::propagate_on_container_move_assignment::value &&
+        alloc_ != other.alloc_) {
+      *this = other;
+      other.clear();
+    } else if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  };
+
+  iterator begin() noexcept {
+    if (root_ == nullptr) return end();
+    Node* node = root_;
+    while (!node->leaf) node = child(node, 0);
+    return iterator(node, 0);
+  };
+
+  const_iterator begin() const noexcept {
+    return const_cast<BTree*>(this)->begin();
+  };
+
+  iterator end() noexcept {
+    return iterator(root_, root_ ? root_->count : 0);
+  };
+
+  const_iterator end() const noexcept {
+    return const_cast<BTree*>(this)->end();
+  };
+
+  key_compare key_comp() const { return compare_storage::get(); };
+
+  allocator_type get_allocator() const noexcept { return alloc_; };
+
+  bool empty() const noexcept { return size_ == 0; };
+
+  size_type size() const noexcept { return size_; };
+
+  size_type max_size() const noexcept {
+    return std::numeric_limits<size_type>::max() / sizeof(InternalNode) *
+           kSlots;
+  };
+
+  void clear() noexcept {
+    if (root_) free_subtree(root_);
+    root_ = nullptr;
+    size_ = 0;
+  };
+
+  void swap(BTree& other) noexcept {
+    compare_storage::swap(other);
+    if (alloc_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_, other.alloc_);
+    }
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+  };
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return insert_value(const_iterator(), true, value, value);
+  };
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return insert_value(const_iterator(), true, value, std::move(value));
+  };
+
+  iterator insert_duplicate(const value_type& value) {
+    return insert_value(const_iterator(), false, value, value).first;
+  };
+
+  iterator insert_duplicate(value_type&& value) {
+    return insert_value(const_iterator(), false, value, std::move(value))
+        .first;
+  };
+
+  // A value passed whole is built straight into its slot. Other arguments
+  // have to make the value first to find the slot, and it is moved in.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return emplace_value(const_iterator(), true, std::forward<Args>(args)...);
+  };
+
+  template <typename... Args>
+  iterator emplace_duplicate(Args&&... args) {
+    return emplace_value(const_iterator(), false, std::forward<Args>(args)...)
+        .first;
+  };
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return emplace_value(hint, true, std::forward<Args>(args)...).first;
+  };
+
+  template <typename... Args>
+  iterator emplace_hint_duplicate(const_iterator hint, Args&&... args) {
+    return emplace_value(hint, false, std::forward<Args>(args)...).first;
+  };
+
+  // Builds the value from args in the slot that key leads to, so a map can
+  // place a pair by its key alone. key must order as the value will.
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplace_key(const_iterator hint, const K& key,
+                                        Args&&... args) {
+    return insert_value(hint, true, key, std::forward<Args>(args)...);
+  };
+
+  // Each insert invalidates the iterators returned before it, so the
+  // positions are looked up once all values are in.
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    return insert_all({value_type(std::forward<Args>(args))...}, true);
+  };
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many_duplicate(
+      Args&&... args) {
+    return insert_all({value_type(std::forward<Args>(args))...}, false);
+  };
+
+  void erase(iterator pos) {
+    if (pos == end()) return;
+    Node* node = pos.node_;
+    size_type index = pos.position_;
+    destroy_value(node, index);
+    if (!node->leaf) {
+      // The predecessor, last in the rightmost leaf of the left subtree,
+      // takes the place of the erased separator.
+      Node* leaf = child(node, index);
+      while (!leaf->leaf) leaf = child(leaf, leaf->count);
+      relocate(node, index, leaf, leaf->count - 1);
+      node = leaf;
+    } else {
+      for (size_type i = index + 1; i < node->count; ++i)
+        relocate(node, i - 1, node, i);
+    }
+    node->count--;
+    size_--;
+    rebalance(node);
+  };
+
+  void merge(BTree& other) {
+    if (this == &other) return;
+    BTree rest(other.key_comp(), other.alloc_);
+    for (iterator it = other.begin(); it != other.end(); ++it) {
+      if (find(*it) == end())
+        insert_value(const_iterator(), false, *it, std::move(*it));
+      else
+        rest.append(std::move(*it));
+    }
+    other.swap(rest);
+  };
+
+  void merge_duplicates(BTree& other) {
+    if (this == &other) return;
+    for (iterator it = other.begin(); it != other.end(); ++it)
+      insert_value(const_iterator(), false, *it, std::move(*it));
+    other.clear();
+  };
+
+  template <typename K = Key>
+  iterator find(const key_arg<K>& key) noexcept {
+    iterator it = lower_bound<K>(key);
+    if (it == end() || compare(key, *it)) return end();
+    return it;
+  };
+
+  template <typename K = Key>
+  const_iterator find(const key_arg<K>& key) const noexcept {
+    return const_cast<BTree*>(this)->template find<K>(key);
+  };
+
+  template <typename K = Key>
+  bool contains(const key_arg<K>& key) const noexcept {
+    return find<K>(key) != end();
+  };
+
+  template <typename K = Key>
+  size_type count(const key_arg<K>& key) const noexcept {
+    size_type c = 0;
+    const_iterator last = end();
+    for (const_iterator it = lower_bound<K>(key);
+         it != last && !compare(key, *it); ++it)
+      c++;
+    return c;
+  };
+
+  template <typename K = Key>
+  iterator lower_bound(const key_arg<K>& key) noexcept {
+    if (root_ == nullptr) return end();
+    Node* node = root_;
+    while (true) {
+      size_type pos = lower_in(node, key);
+      if (node->leaf) return iterator(node, pos).climbed();
+      node = child(node, pos);
+    }
+  };
+
+  template <typename K = Key>
+  const_iterator lower_bound(const key_arg<K>& key) const noexcept {
+    return const_cast<BTree*>(this)->template lower_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  iterator upper_bound(const key_arg<K>& key) noexcept {
+    if (root_ == nullptr) return end();
+    Node* node = root_;
+    while (true) {
+      size_type pos = upper_in(node, key);
+      if (node->leaf) return iterator(node, pos).climbed();
+      node = child(node, pos);
+    }
+  };
+
+  template <typename K = Key>
+  const_iterator upper_bound(const key_arg<K>& key) const noexcept {
+    return const_cast<BTree*>(this)->template upper_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  std::pair<iterator, iterator> equal_range(const key_arg<K>& key) noexcept {
+    return {lower_bound<K>(key), upper_bound<K>(key)};
+  };
+
+  template <typename K = Key>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_arg<K>& key) const noexcept {
+    return {lower_bound<K>(key), upper_bound<K>(key)};
+  };
+
+ private:
+  template <typename A, typename B>
+  bool compare(const A& a, const B& b) const {
+    return compare_storage::get()(a, b);
+  };
+
+  struct Node {
+    InternalNode* parent = nullptr;
+    std::uint16_t position = 0;  // index among the parent's children
+    std::uint16_t count = 0;
+    bool leaf = true;
+    alignas(Key) unsigned char storage[kSlots * sizeof(Key)];
+
+    Key& value(size_type i) noexcept {
+      return std::launder(reinterpret_cast<Key*>(storage))[i];
+    };
+  };
+
+  struct InternalNode : Node {
+    InternalNode() { this->leaf = false; };
+
+    Node* children[kSlots + 1] = {};
+  };
+
+  static Node* child(Node* node, size_type i) noexcept {
+    return static_cast<InternalNode*>(node)->children[i];
+  };
+
+  static void set_child(Node* node, size_type i, Node* c) noexcept {
+    static_cast<InternalNode*>(node)->children[i] = c;
+    c->parent = static_cast<InternalNode*>(node);
+    c->position = static_cast<std::uint16_t>(i);
+  };
+
+  template <typename K>
+  size_type lower_in(Node* node, const K& key) const {
+    size_type lo = 0, hi = node->count;
+    while (lo < hi) {
+      size_type mid = (lo + hi) / 2;
+      if (compare(node->value(mid), key))
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    return lo;
+  };
+
+  template <typename K>
+  size_type upper_in(Node* node, const K& key) const {
+    size_type lo = 0, hi = node->count;
+    while (lo < hi) {
+      size_type mid = (lo + hi) / 2;
+      if (compare(key, node->value(mid)))
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+    return lo;
+  };
+
+  template <typename... Args>
+  void construct_value(Node* node, size_type i, Args&&... args) {
+    alloc_traits::construct(alloc_, &node->value(i),
+                            std::forward<Args>(args)...);
+  };
+
+  void destroy_value(Node* node, size_type i) noexcept {
+    alloc_traits::destroy(alloc_, &node->value(i));
+  };
+
+  // Moves a value into an empty slot and leaves its old slot empty.
+  void relocate(Node* to, size_type i, Node* from, size_type j) {
+    construct_value(to, i, std::move(from->value(j)));
+    destroy_value(from, j);
+  };
+
+  Node* new_leaf() {
+    leaf_allocator alloc(alloc_);
+    Node* node = leaf_traits::allocate(alloc, 1);
+    return new (node) Node();
+  };
+
+  InternalNode* new_internal() {
+    internal_allocator alloc(alloc_);
+    InternalNode* node = internal_traits::allocate(alloc, 1);
+    return new (node) InternalNode();
+  };
+
+  // Gives back a node whose values are already destroyed or moved out.
+  void free_node(Node* node) noexcept {
+    if (node->leaf) {
+      leaf_allocator alloc(alloc_);
+      leaf_traits::deallocate(alloc, node, 1);
+    } else {
+      internal_allocator alloc(alloc_);
+      internal_traits::deallocate(alloc, static_cast<InternalNode*>(node), 1);
+    }
+  };
+
+  void free_subtree(Node* node) noexcept {
+    for (size_type i = 0; i < node->count; ++i) destroy_value(node, i);
+    if (!node->leaf) {
+      for (size_type i = 0; i <= node->count; ++i)
+        if (child(node, i)) free_subtree(child(node, i));
+    }
+    free_node(node);
+  };
+
+  // On an exception the partial copy is freed: values are counted as they
+  // are constructed and children not yet copied are still null.
+  Node* copy(Node* from, InternalNode* parent) {
+    Node* node = from->leaf ? new_leaf() : new_internal();
+    try {
+      for (; node->count < from->count; ++node->count)
+        construct_value(node, node->count, from->value(node->count));
+      if (!node->leaf) {
+        for (size_type i = 0; i <= from->count; ++i)
+          set_child(node, i,
+                    copy(child(from, i), static_cast<InternalNode*>(node)));
+      }
+    } catch (...) {
+      free_subtree(node);
+      throw;
+    }
+    node->parent = parent;
+    node->position = from->position;
+    return node;
+  };
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace_value(const_iterator hint, bool unique,
+                                          Args&&... args) {
+    if constexpr (std::conjunction<
+                      std::bool_constant<sizeof...(Args) == 1>,
+                      std::is_same<std::decay_t<Args>, value_type>...>::value) {
+      return insert_value(hint, unique, args..., std::forward<Args>(args)...);
+    } else {
+      value_type value(std::forward<Args>(args)...);
+      return insert_value(hint, unique, value, std::move(value));
+    }
+  };
+
+  // Builds the value from args in the slot found for key. Unique trees go
+  // to the lower bound and stop at an equal value met on the way down;
+  // duplicates go after the last equal value. A hint the value belongs
+  // right before saves the descent; a default const_iterator is no hint.
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> insert_value(const_iterator hint, bool unique,
+                                         const K& key, Args&&... args) {
+    iterator pos = hint.it_;
+    if (pos.node_ != nullptr && fits_before(pos, key, unique)) {
+      Node* node = pos.node_;
+      size_type slot = pos.position_;
+      if (!node->leaf) {
+        node = child(node, slot);
+        while (!node->leaf) node = child(node, node->count);
+        slot = node->count;
+      }
+      return {insert_at(node, slot, std::forward<Args>(args)...), true};
+    }
+    if (root_ == nullptr) root_ = new_leaf();
+    Node* node = root_;
+    size_type slot;
+    while (true) {
+      slot = unique ? lower_in(node, key) : upper_in(node, key);
+      if (unique && slot < node->count && !compare(key, node->value(slot)))
+        return {iterator(node, slot), false};
+      if (node->leaf) break;
+      node = child(node, slot);
+    }
+    return {insert_at(node, slot, std::forward<Args>(args)...), true};
+  };
+
+  template <typename K>
+  bool fits_before(iterator pos, const K& key, bool unique) {
+    if (pos != end() && (unique ? !compare(key, *pos) : compare(*pos, key)))
+      return false;
+    if (pos == begin()) return true;
+    --pos;
+    return unique ? compare(*pos, key) : !compare(key, *pos);
+  };
+
+  // Appends a value known to order after everything in the tree.
+  template <typename V>
+  void append(V&& value) {
+    if (root_ == nullptr) root_ = new_leaf();
+    Node* node = root_;
+    while (!node->leaf) node = child(node, node->count);
+    insert_at(node, node->count, std::forward<V>(value));
+  };
+
+  template <typename... Args>
+  iterator insert_at(Node* node, size_type pos, Args&&... args) {
+    if ((stored_above(node, std::addressof(args)) || ...)) {
+      // An argument that lives in the tree, such as a duplicate of one of
+      // its values, would be moved away by the shifts and splits below.
+      value_type value(std::forward<Args>(args)...);
+      return insert_at(node, pos, std::move(value));
+    }
+    if (node->count == kSlots) split(node, pos);
+    for (size_type i = node->count; i > pos; --i)
+      relocate(node, i, node, i - 1);
+    try {
+      construct_value(node, pos, std::forward<Args>(args)...);
+    } catch (...) {
+      for (size_type i = pos; i < node->count; ++i)
+        relocate(node, i, node, i + 1);
+      throw;
+    }
+    node->count++;
+    size_++;
+    return iterator(node, pos);
+  };
+
+  // Whether object is stored in node or one of its ancestors, the nodes an
+  // insert into node may move values in.
+  static bool stored_above(Node* node, const void* object) noexcept {
+    std::less<const void*> before;
+    for (; node != nullptr; node = node->parent) {
+      const unsigned char* first = node->storage;
+      if (!before(object, first) &&
+          before(object, first + node->count * sizeof(Key)))
+        return true;
+    }
+    return false;
+  };
+
+  // Splits a full node so that a value (or, for an internal node, a
+  // separator and the child after it) fits at pos, and points node and pos
+  // at the slot it belongs to afterwards. Appends at either end leave the
+  // old node nearly full, which keeps sorted loads dense.
+  void split(Node*& node, size_type& pos) {
+    InternalNode* parent = node->parent;
+    if (parent == nullptr) {
+      parent = new_internal();
+      set_child(parent, 0, node);
+      root_ = parent;
+    } else if (parent->count == kSlots) {
+      Node* up = parent;
+      size_type up_pos = node->position;
+      split(up, up_pos);
+      parent = node->parent;
+    }
+    Node* sibling = node->leaf ? new_leaf() : new_internal();
+    size_type count = node->count;
+    size_type left = pos == count ? count - 2 : pos == 0 ? 1 : count / 2;
+    sibling->count = static_cast<std::uint16_t>(count - left - 1);
+    for (size_type i = 0; i < sibling->count; ++i)
+      relocate(sibling, i, node, left + 1 + i);
+    if (!node->leaf) {
+      for (size_type i = 0; i <= sibling->count; ++i)
+        set_child(sibling, i, child(node, left + 1 + i));
+    }
+    insert_separator(parent, node->position, node, left, sibling);
+    node->count = static_cast<std::uint16_t>(left);
+    if (pos > left) {
+      pos -= left + 1;
+      node = sibling;
+    }
+  };
+
+  // Moves value i of from into parent at index pos, with child after it.
+  void insert_separator(Node* parent, size_type pos, Node* from, size_type i,
+                        Node* after) {
+    for (size_type j = parent->count; j > pos; --j) {
+      relocate(parent, j, parent, j - 1);
+      set_child(parent, j + 1, child(parent, j));
+    }
+    relocate(parent, pos, from, i);
+    set_child(parent, pos + 1, after);
+    parent->count++;
+  };
+
+  // Restores the minimum fill of node after an erase by borrowing a value
+  // from a sibling or by merging with one, which may leave the parent short
+  // in turn. An emptied root hands over to its only child.
+  void rebalance(Node* node) {
+    while (node != root_ && node->count < kMinValues) {
+      InternalNode* parent = node->parent;
+      size_type pos = node->position;
+      Node* left = pos > 0 ? child(parent, pos - 1) : nullptr;
+      Node* right = pos < parent->count ? child(parent, pos + 1) : nullptr;
+      if (left && left->count > kMinValues) {
+        borrow_from_left(parent, pos);
+        return;
+      }
+      if (right && right->count > kMinValues) {
+        borrow_from_right(parent, pos);
+        return;
+      }
+      merge_children(parent, left ? pos - 1 : pos);
+      node = parent;
+    }
+    if (root_->count == 0) {
+      Node* old = root_;
+      root_ = old->leaf ? nullptr : child(old, 0);
+      if (root_) {
+        root_->parent = nullptr;
+        root_->position = 0;
+      }
+      free_node(old);
+    }
+  };
+
+  void borrow_from_left(Node* parent, size_type pos) {
+    Node* node = child(parent, pos);
+    Node* left = child(parent, pos - 1);
+    for (size_type i = node->count; i > 0; --i) relocate(node, i, node, i - 1);
+    if (!node->leaf) {
+      for (size_type i = node->count + 1; i > 0; --i)
+        set_child(node, i, child(node, i - 1));
+      set_child(node, 0, child(left, left->count));
+    }
+    relocate(node, 0, parent, pos - 1);
+    relocate(parent, pos - 1, left, left->count - 1);
+    left->count--;
+    node->count++;
+  };
+
+  void borrow_from_right(Node* parent, size_type pos) {
+    Node* node = child(parent, pos);
+    Node* right = child(parent, pos + 1);
+    relocate(node, node->count, parent, pos);
+    if (!node->leaf) set_child(node, node->count + 1, child(right, 0));
+    relocate(parent, pos, right, 0);
+    for (size_type i = 1; i < right->count; ++i)
+      relocate(right, i - 1, right, i);
+    if (!right->leaf) {
+      for (size_type i = 1; i <= right->count; ++i)
+        set_child(right, i - 1, child(right, i));
+    }
+    node->count++;
+    right->count--;
+  };
+
+  // Folds child pos + 1 and the separator before it into child pos.
+  void merge_children(Node* parent, size_type pos) {
+    Node* left = child(parent, pos);
+    Node* right = child(parent, pos + 1);
+    size_type base = left->count + 1;
+    relocate(left, left->count, parent, pos);
+    for (size_type i = 0; i < right->count; ++i)
+      relocate(left, base + i, right, i);
+    if (!left->leaf) {
+      for (size_type i = 0; i <= right->count; ++i)
+        set_child(left, base + i, child(right, i));
+    }
+    left->count = static_cast<std::uint16_t>(base + right->count);
+    for (size_type i = pos + 1; i < parent->count; ++i) {
+      relocate(parent, i - 1, parent, i);
+      set_child(parent, i, child(parent, i + 1));
+    }
+    parent->count--;
+    free_node(right);
+  };
+
+  std::vector<std::pair<iterator, bool>> insert_all(
+      std::initializer_list<value_type> values, bool unique) {
+    std::vector<bool> inserted;
+    inserted.reserve(values.size());
+    for (const value_type& value : values)
+      inserted.push_back(
+          insert_value(const_iterator(), unique, value, value).second);
+    std::vector<std::pair<iterator, bool>> result;
+    result.reserve(values.size());
+    auto done = inserted.begin();
+    for (const value_type& value : values)
+      result.push_back({find(value), *done++});
+    return result;
+  };
+
+  class BTreeIterator {
+    friend BTree;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = Key*;
+    using reference = Key&;
+
+    BTreeIterator() = default;
+
+    reference operator*() const noexcept { return node_->value(position_); };
+
+    pointer operator->() const noexcept { return &node_->value(position_); };
+
+    bool operator==(const iterator& other) const noexcept {
+      return node_ == other.node_ && position_ == other.position_;
+    };
+
+    bool operator!=(const iterator& other) const noexcept {
+      return !(*this == other);
+    };
+
+    iterator& operator++() noexcept {
+      if (!node_->leaf) {
+        node_ = child(node_, position_ + 1);
+        while (!node_->leaf) node_ = child(node_, 0);
+        position_ = 0;
+      } else {
+        ++position_;
+        climb();
+      }
+      return *this;
+    };
+
+    iterator operator++(int) noexcept {
+      iterator temp(*this);
+      ++(*this);
+      return temp;
+    };
+
+    iterator& operator--() noexcept {
+      if (!node_->leaf) {
+        node_ = child(node_, position_);
+        while (!node_->leaf) node_ = child(node_, node_->count);
+        position_ = node_->count - 1;
+      } else if (position_ > 0) {
+        --position_;
+      } else {
+        while (node_->position == 0) node_ = node_->parent;
+        position_ = node_->position - 1;
+        node_ = node_->parent;
+      }
+      return *this;
+    };
+
+    iterator operator--(int) noexcept {
+      iterator temp(*this);
+      --(*this);
+      return temp;
+    };
+
+   private:
+    BTreeIterator(Node* node, size_type position)
+        : node_(node), position_(position){};
+
+    // Past the last value of a node the walk continues at the separator
+    // above it; past the root it stops at end().
+    void climb() noexcept {
+      while (position_ == node_->count && node_->parent) {
+        position_ = node_->position;
+        node_ = node_->parent;
+      }
+    };
+
+    iterator climbed() noexcept {
+      if (node_) climb();
+      return *this;
+    };
+
+    Node* node_ = nullptr;
+    size_type position_ = 0;
+  };
+
+  class BTreeConstIterator {
+    friend BTree;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = Key;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Key*;
+    using reference = const Key&;
+
+    BTreeConstIterator() = default;
+    BTreeConstIterator(const iterator& other) : it_(other){};
+
+    reference operator*() const noexcept { return *it_; };
+
+    pointer operator->() const noexcept { return &*it_; };
+
+    const_iterator& operator++() noexcept {
+      ++it_;
+      return *this;
+    };
+
+    const_iterator operator++(int) noexcept {
+      const_iterator temp(*this);
+      ++it_;
+      return temp;
+    };
+
+    const_iterator& operator--() noexcept {
+      --it_;
+      return *this;
+    };
+
+    const_iterator operator--(int) noexcept {
+      const_iterator temp(*this);
+      --it_;
+      return temp;
+    };
+
+    friend bool operator==(const const_iterator& it1,
+                           const const_iterator& it2) noexcept {
+      return it1.it_ == it2.it_;
+    };
+
+    friend bool operator!=(const const_iterator& it1,
+                           const const_iterator& it2) noexcept {
+      return it1.it_ != it2.it_;
+    };
+
+   private:
+    iterator it_;
+  };
+
+  Node* root_ = nullptr;
+  size_type size_ = 0;
+  Allocator alloc_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_BTREE_H_
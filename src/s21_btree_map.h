@@ -0,0 +1,250 @@
+#ifndef SRC_S21_BTREE_MAP_H_
+#define SRC_S21_BTREE_MAP_H_
+
+#include <memory_resource>
+#include <stdexcept>
+
+#include "s21_btree.h"
+#include "s21_compare.h"
+
+namespace s21 {
+// map over a B-tree, see btree_set. Pairs are ordered by key with the same
+// value_compare as s21::map. Any insert or erase invalidates every iterator
+// and every reference to a mapped value.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class btree_map {
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
+
+ public:
+  using key_compare = Compare;
+  using value_compare = PairKeyCompare<Key, T, Compare>;
+
+ private:
+  using tree = BTree<value_type, value_compare, Allocator>;
+
+ public:
+  using iterator = typename tree::iterator;
+  using const_iterator = typename tree::const_iterator;
+  using allocator_type = Allocator;
+
+  btree_map() = default;
+
+  explicit btree_map(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_(value_compare(comp), alloc){};
+
+  explicit btree_map(const Allocator& alloc)
+      : tree_(value_compare(Compare()), alloc){};
+
+  btree_map(std::initializer_list<value_type> const& items,
+            const Compare& comp = Compare(),
+            const Allocator& alloc = Allocator())
+      : tree_(value_compare(comp), alloc) {
+    for (const_reference item : items) tree_.insert(item);
+  };
+
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  btree_map(InputIt first, InputIt last, const Compare& comp = Compare(),
+            const Allocator& alloc = Allocator())
+      : tree_(value_compare(comp), alloc) {
+    for (; first != last; ++first) tree_.insert(*first);
+  };
+
+  btree_map(const btree_map& m) : tree_(m.tree_){};
+
+  btree_map(const btree_map& m, const Allocator& alloc)
+      : tree_(m.tree_, alloc){};
+
+  btree_map(btree_map&& m) : tree_(std::move(m.tree_)){};
+
+  ~btree_map() = default;
+
+  btree_map& operator=(const btree_map& m) {
+    tree_ = m.tree_;
+    return *this;
+  };
+
+  btree_map& operator=(btree_map&& m) {
+    tree_ = std::move(m.tree_);
+    return *this;
+  };
+
+  T& at(const Key& key) {
+    iterator it = tree_.find(key);
+    if (it == tree_.end()) throw std::out_of_range("btree_map::at");
+    return (*it).second;
+  };
+
+  const T& at(const Key& key) const {
+    const_iterator it = tree_.find(key);
+    if (it == tree_.end()) throw std::out_of_range("btree_map::at");
+    return (*it).second;
+  };
+
+  T& operator[](const Key& key) {
+    return (*tree_
+                 .emplace_key(const_iterator(), key, std::piecewise_construct,
+                              std::forward_as_tuple(key), std::tuple<>())
+                 .first)
+        .second;
+  };
+
+  iterator begin() noexcept { return tree_.begin(); };
+
+  iterator end() noexcept { return tree_.end(); };
+
+  const_iterator begin() const noexcept { return tree_.begin(); };
+
+  const_iterator end() const noexcept { return tree_.end(); };
+
+  key_compare key_comp() const { return tree_.key_comp().key_comp(); };
+
+  value_compare value_comp() const { return tree_.key_comp(); };
+
+  bool empty() const noexcept { return tree_.empty(); };
+
+  size_type size() const noexcept { return tree_.size(); };
+
+  size_type max_size() const noexcept { return tree_.max_size(); };
+
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
+  void clear() { tree_.clear(); };
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return tree_.insert(value);
+  };
+
+  std::pair<iterator, bool> insert(const Key& key, const T& obj) {
+    return tree_.emplace_key(const_iterator(), key, key, obj);
+  };
+
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
+    auto res = tree_.emplace_key(const_iterator(), key, key, obj);
+    if (!res.second) (*res.first).second = obj;
+    return res;
+  };
+
+  // A hint just past where the pair belongs saves the descent.
+  iterator insert(const_iterator hint, const_reference value) {
+    return tree_.emplace_hint(hint, value);
+  };
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    if constexpr (IsKeyAndMapped<Args...>::value) {
+      return emplace_pair(const_iterator(), std::forward<Args>(args)...);
+    } else {
+      return tree_.emplace(std::forward<Args>(args)...);
+    }
+  };
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    if constexpr (IsKeyAndMapped<Args...>::value) {
+      return emplace_pair(hint, std::forward<Args>(args)...).first;
+    } else {
+      return tree_.emplace_hint(hint, std::forward<Args>(args)...);
+    }
+  };
+
+  void erase(iterator pos) { tree_.erase(pos); };
+
+  void swap(btree_map& other) { tree_.swap(other.tree_); };
+
+  void merge(btree_map& other) { tree_.merge(other.tree_); };
+
+  template <typename K = Key>
+  bool contains(const key_arg<K>& key) const noexcept {
+    return tree_.contains(key);
+  };
+
+  template <typename K = Key>
+  iterator find(const key_arg<K>& key) noexcept {
+    return tree_.find(key);
+  };
+
+  template <typename K = Key>
+  const_iterator find(const key_arg<K>& key) const noexcept {
+    return tree_.find(key);
+  };
+
+  template <typename K = Key>
+  size_type count(const key_arg<K>& key) const noexcept {
+    return tree_.contains(key) ? 1 : 0;
+  };
+
+  template <typename K = Key>
+  std::pair<iterator, iterator> equal_range(const key_arg<K>& key) noexcept {
+    return tree_.equal_range(key);
+  };
+
+  template <typename K = Key>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_arg<K>& key) const noexcept {
+    return tree_.equal_range(key);
+  };
+
+  template <typename K = Key>
+  iterator lower_bound(const key_arg<K>& key) noexcept {
+    return tree_.lower_bound(key);
+  };
+
+  template <typename K = Key>
+  const_iterator lower_bound(const key_arg<K>& key) const noexcept {
+    return tree_.lower_bound(key);
+  };
+
+  template <typename K = Key>
+  iterator upper_bound(const key_arg<K>& key) noexcept {
+    return tree_.upper_bound(key);
+  };
+
+  template <typename K = Key>
+  const_iterator upper_bound(const key_arg<K>& key) const noexcept {
+    return tree_.upper_bound(key);
+  };
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    return tree_.insert_many(std::forward<Args>(args)...);
+  };
+
+ private:
+  // A Key and a mapped value are built into the pair in its slot; other
+  // arguments make the pair first to find the slot.
+  template <typename... Args>
+  struct IsKeyAndMapped : std::false_type {};
+
+  template <typename K, typename M>
+  struct IsKeyAndMapped<K, M> : std::is_same<std::decay_t<K>, Key> {};
+
+  template <typename K, typename M>
+  std::pair<iterator, bool> emplace_pair(const_iterator hint, K&& key,
+                                         M&& obj) {
+    return tree_.emplace_key(hint, key, std::forward<K>(key),
+                             std::forward<M>(obj));
+  };
+
+  tree tree_{};
+};
+
+namespace pmr {
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using btree_map =
+    s21::btree_map<Key, T, Compare,
+                   std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_BTREE_MAP_H_
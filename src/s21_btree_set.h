@@ -0,0 +1,188 @@
+#ifndef SRC_S21_BTREE_SET_H_
+#define SRC_S21_BTREE_SET_H_
+
+#include <memory_resource>
+
+#include "s21_btree.h"
+
+namespace s21 {
+// set over a B-tree: the same interface as s21::set for everything that
+// does not depend on nodes, with faster lookups on small keys. Any insert
+// or erase invalidates every iterator.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class btree_set {
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using tree = BTree<value_type, Compare, Allocator>;
+  using size_type = std::size_t;
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
+
+ public:
+  using iterator = typename tree::iterator;
+  using const_iterator = typename tree::const_iterator;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using allocator_type = Allocator;
+
+  btree_set() : tree_(){};
+
+  explicit btree_set(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_(comp, alloc){};
+
+  explicit btree_set(const Allocator& alloc) : tree_(Compare(), alloc){};
+
+  btree_set(std::initializer_list<value_type> const& items,
+            const Compare& comp = Compare(),
+            const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    for (const_reference item : items) tree_.insert(item);
+  };
+
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  btree_set(InputIt first, InputIt last, const Compare& comp = Compare(),
+            const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    for (; first != last; ++first) tree_.insert(*first);
+  };
+
+  btree_set(const btree_set& s) : tree_(s.tree_){};
+
+  btree_set(const btree_set& s, const Allocator& alloc)
+      : tree_(s.tree_, alloc){};
+
+  btree_set(btree_set&& s) : tree_(std::move(s.tree_)){};
+
+  ~btree_set() = default;
+
+  btree_set& operator=(const btree_set& other) {
+    tree_ = other.tree_;
+    return *this;
+  };
+
+  btree_set& operator=(btree_set&& other) {
+    tree_ = std::move(other.tree_);
+    return *this;
+  };
+
+  std::pair<iterator, bool> insert(const_reference key) {
+    return tree_.insert(key);
+  };
+
+  // A hint just past where the value belongs saves the descent.
+  iterator insert(const_iterator hint, const_reference value) {
+    return tree_.emplace_hint(hint, value);
+  };
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return tree_.emplace(std::forward<Args>(args)...);
+  };
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return tree_.emplace_hint(hint, std::forward<Args>(args)...);
+  };
+
+  size_type size() const noexcept { return tree_.size(); };
+
+  size_type max_size() const noexcept { return tree_.max_size(); };
+
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
+  void erase(iterator pos) { tree_.erase(pos); };
+
+  bool empty() const noexcept { return tree_.empty(); };
+
+  void clear() { tree_.clear(); };
+
+  void swap(btree_set& other) { tree_.swap(other.tree_); };
+
+  void merge(btree_set& other) { tree_.merge(other.tree_); };
+
+  template <typename K = Key>
+  bool contains(const key_arg<K>& key) const {
+    return tree_.template contains<K>(key);
+  };
+
+  template <typename K = Key>
+  iterator find(const key_arg<K>& key) {
+    return tree_.template find<K>(key);
+  };
+
+  template <typename K = Key>
+  const_iterator find(const key_arg<K>& key) const {
+    return tree_.template find<K>(key);
+  };
+
+  template <typename K = Key>
+  size_type count(const key_arg<K>& key) const noexcept {
+    return tree_.template contains<K>(key) ? 1 : 0;
+  };
+
+  template <typename K = Key>
+  std::pair<iterator, iterator> equal_range(const key_arg<K>& key) noexcept {
+    return tree_.template equal_range<K>(key);
+  };
+
+  template <typename K = Key>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_arg<K>& key) const noexcept {
+    return tree_.template equal_range<K>(key);
+  };
+
+  template <typename K = Key>
+  iterator lower_bound(const key_arg<K>& key) noexcept {
+    return tree_.template lower_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  const_iterator lower_bound(const key_arg<K>& key) const noexcept {
+    return tree_.template lower_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  iterator upper_bound(const key_arg<K>& key) noexcept {
+    return tree_.template upper_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  const_iterator upper_bound(const key_arg<K>& key) const noexcept {
+    return tree_.template upper_bound<K>(key);
+  };
+
+  iterator begin() noexcept { return tree_.begin(); };
+
+  const_iterator begin() const noexcept { return tree_.begin(); };
+
+  iterator end() noexcept { return tree_.end(); };
+
+  const_iterator end() const noexcept { return tree_.end(); };
+
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  value_compare value_comp() const { return tree_.key_comp(); };
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    return tree_.insert_many(std::forward<Args>(args)...);
+  };
+
+ private:
+  tree tree_;
+};
+
+namespace pmr {
+template <typename Key, typename Compare = std::less<Key>>
+using btree_set =
+    s21::btree_set<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_BTREE_SET_H_
@@ -0,0 +1,102 @@
+#ifndef SRC_S21_COMPARE_H_
+#define SRC_S21_COMPARE_H_
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace s21 {
+// Holds the ordering of a tree. Empty comparators such as std::less are kept
+// as a base class, so they add nothing to the size of the owner.
+template <typename Compare, bool = std::is_empty<Compare>::value &&
+                                   !std::is_final<Compare>::value>
+class CompareStorage : private Compare {
+ public:
+  CompareStorage() = default;
+  explicit CompareStorage(const Compare& comp) : Compare(comp){};
+
+  const Compare& get() const noexcept { return *this; };
+
+  void swap(CompareStorage& other) {
+    using std::swap;
+    swap(static_cast<Compare&>(*this), static_cast<Compare&>(other));
+  };
+};
+
+template <typename Compare>
+class CompareStorage<Compare, false> {
+ public:
+  CompareStorage() = default;
+  explicit CompareStorage(const Compare& comp) : comp_(comp){};
+
+  const Compare& get() const noexcept { return comp_; };
+
+  void swap(CompareStorage& other) {
+    using std::swap;
+    swap(comp_, other.comp_);
+  };
+
+ private:
+  Compare comp_{};
+};
+
+template <typename Compare, typename = void>
+struct IsTransparent : std::false_type {};
+
+template <typename Compare>
+struct IsTransparent<Compare, std::void_t<typename Compare::is_transparent>>
+    : std::true_type {};
+
+template <bool Transparent>
+struct LookupKey {
+  template <typename K, typename Key>
+  using type = Key;
+};
+
+template <>
+struct LookupKey<true> {
+  template <typename K, typename Key>
+  using type = K;
+};
+
+// Lookup argument of find/contains/count/bounds: any K when the comparator is
+// transparent, Key otherwise. Both branches keep K deducible, so a call like
+// find("abc") on a string set with std::less<> builds no temporary string.
+template <typename Compare, typename K, typename Key>
+using LookupKeyType = typename LookupKey<
+    IsTransparent<Compare>::value>::template type<K, Key>;
+
+// Orders key-value pairs by key only, so a tree descends on the key and
+// never looks at the mapped value. It also compares a pair with a bare key,
+// which lets a tree search for a key without building a probe pair. This is
+// the value_compare of every map.
+template <typename Key, typename T, typename Compare>
+class PairKeyCompare : private CompareStorage<Compare> {
+  using value_type = std::pair<const Key, T>;
+
+ public:
+  using is_transparent = void;
+
+  PairKeyCompare() = default;
+  explicit PairKeyCompare(const Compare& comp)
+      : CompareStorage<Compare>(comp){};
+
+  bool operator()(const value_type& a, const value_type& b) const {
+    return this->get()(a.first, b.first);
+  };
+
+  template <typename K>
+  bool operator()(const value_type& a, const K& key) const {
+    return this->get()(a.first, key);
+  };
+
+  template <typename K>
+  bool operator()(const K& key, const value_type& b) const {
+    return this->get()(key, b.first);
+  };
+
+  Compare key_comp() const { return this->get(); };
+};
+}  // namespace s21
+
+#endif  // SRC_S21_COMPARE_H_
@@ -2,6 +2,14 @@
 #define SRC_S21_CONTAINERS_H_
 
 #include "s21_array.h"
+#include "s21_btree_map.h"
+#include "s21_btree_multiset.h"
+#include "s21_btree_set.h"
+#include "s21_flat_map.h"
+#include "s21_flat_multiset.h"
+#include "s21_flat_set.h"
+#include "s21_frozen_map.h"
+#include "s21_frozen_set.h"
 #include "s21_list.h"
 #include "s21_map.h"
 #include "s21_multiset.h"
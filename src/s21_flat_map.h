@@ -0,0 +1,399 @@
+#ifndef SRC_S21_FLAT_MAP_H_
+#define SRC_S21_FLAT_MAP_H_
+
+#include <memory_resource>
+#include <stdexcept>
+
+#include "s21_compare.h"
+#include "s21_flat_tree.h"
+
+namespace s21 {
+// map over sorted Vectors, see flat_set. Keys and mapped values live in two
+// separate Vectors, so a lookup searches keys only and never pulls values
+// into the cache. There is therefore no pair object to point at: iterators
+// yield a std::pair<const Key&, T&> of references into both columns. Any
+// insert or erase invalidates every iterator and every reference to a
+// mapped value.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class flat_map {
+  template <bool Const>
+  class FlatMapIterator;
+
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using const_reference = const value_type&;
+  using size_type = std::size_t;
+  using tree = FlatTree<Key, T, Compare, Allocator>;
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
+
+ public:
+  using key_compare = Compare;
+  using value_compare = PairKeyCompare<Key, T, Compare>;
+  using iterator = FlatMapIterator<false>;
+  using const_iterator = FlatMapIterator<true>;
+  using allocator_type = Allocator;
+
+  flat_map() = default;
+
+  explicit flat_map(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_(comp, alloc){};
+
+  explicit flat_map(const Allocator& alloc) : tree_(Compare(), alloc){};
+
+  flat_map(std::initializer_list<value_type> const& items,
+           const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.insert_range(items.begin(), items.end(), false);
+  };
+
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  flat_map(InputIt first, InputIt last, const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.insert_range(first, last, false);
+  };
+
+  flat_map(const flat_map& m) : tree_(m.tree_){};
+
+  flat_map(const flat_map& m, const Allocator& alloc)
+      : tree_(m.tree_, alloc){};
+
+  flat_map(flat_map&& m) : tree_(std::move(m.tree_)){};
+
+  ~flat_map() = default;
+
+  flat_map& operator=(const flat_map& m) {
+    tree_ = m.tree_;
+    return *this;
+  };
+
+  flat_map& operator=(flat_map&& m) {
+    tree_ = std::move(m.tree_);
+    return *this;
+  };
+
+  T& at(const Key& key) {
+    size_type index = tree_.find(key);
+    if (index == size()) throw std::out_of_range("flat_map::at");
+    return tree_.values()[index];
+  };
+
+  const T& at(const Key& key) const {
+    size_type index = tree_.find(key);
+    if (index == size()) throw std::out_of_range("flat_map::at");
+    return tree_.values()[index];
+  };
+
+  T& operator[](const Key& key) {
+    size_type index = tree_.insert(key).first;
+    return tree_.values()[index];
+  };
+
+  iterator begin() noexcept { return iterator_at(0); };
+
+  iterator end() noexcept { return iterator_at(size()); };
+
+  const_iterator begin() const noexcept { return iterator_at(0); };
+
+  const_iterator end() const noexcept { return iterator_at(size()); };
+
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  value_compare value_comp() const { return value_compare(key_comp()); };
+
+  bool empty() const noexcept { return tree_.empty(); };
+
+  size_type size() const noexcept { return tree_.size(); };
+
+  size_type max_size() const noexcept { return tree_.max_size(); };
+
+  size_type capacity() const noexcept { return tree_.capacity(); };
+
+  void reserve(size_type count) { tree_.reserve(count); };
+
+  void shrink_to_fit() { tree_.shrink_to_fit(); };
+
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
+  void clear() { tree_.clear(); };
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return iterator_at(tree_.insert(value.first, value.second));
+  };
+
+  std::pair<iterator, bool> insert(const Key& key, const T& obj) {
+    return iterator_at(tree_.insert(key, obj));
+  };
+
+  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
+    auto res = tree_.insert(key, obj);
+    if (!res.second) tree_.values()[res.first] = obj;
+    return iterator_at(res);
+  };
+
+  iterator insert(const_iterator hint, const_reference value) {
+    return iterator_at(
+               tree_.insert_hint(index_of(hint), value.first, value.second))
+        .first;
+  };
+
+  // Sorts [first, last) and merges it in: O(n + m log m) for m new pairs.
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  void insert(InputIt first, InputIt last) {
+    tree_.insert_range(first, last, false);
+  };
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    std::pair<Key, T> item(std::forward<Args>(args)...);
+    return iterator_at(
+        tree_.insert(std::move(item.first), std::move(item.second)));
+  };
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    std::pair<Key, T> item(std::forward<Args>(args)...);
+    return iterator_at(tree_.insert_hint(index_of(hint), std::move(item.first),
+                                         std::move(item.second)))
+        .first;
+  };
+
+  void erase(iterator pos) { tree_.erase(index_of(pos)); };
+
+  void swap(flat_map& other) { tree_.swap(other.tree_); };
+
+  void merge(flat_map& other) { tree_.merge(other.tree_, false); };
+
+  template <typename K = Key>
+  bool contains(const key_arg<K>& key) const noexcept {
+    return tree_.template find<K>(key) != size();
+  };
+
+  template <typename K = Key>
+  iterator find(const key_arg<K>& key) noexcept {
+    return iterator_at(tree_.template find<K>(key));
+  };
+
+  template <typename K = Key>
+  const_iterator find(const key_arg<K>& key) const noexcept {
+    return iterator_at(tree_.template find<K>(key));
+  };
+
+  template <typename K = Key>
+  size_type count(const key_arg<K>& key) const noexcept {
+    return contains<K>(key) ? 1 : 0;
+  };
+
+  template <typename K = Key>
+  std::pair<iterator, iterator> equal_range(const key_arg<K>& key) noexcept {
+    size_type index = tree_.template lower_bound<K>(key);
+    bool found = index != size() && !key_comp()(key, tree_.keys()[index]);
+    return {iterator_at(index), iterator_at(index + found)};
+  };
+
+  template <typename K = Key>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_arg<K>& key) const noexcept {
+    size_type index = tree_.template lower_bound<K>(key);
+    bool found = index != size() && !key_comp()(key, tree_.keys()[index]);
+    return {iterator_at(index), iterator_at(index + found)};
+  };
+
+  template <typename K = Key>
+  iterator lower_bound(const key_arg<K>& key) noexcept {
+    return iterator_at(tree_.template lower_bound<K>(key));
+  };
+
+  template <typename K = Key>
+  const_iterator lower_bound(const key_arg<K>& key) const noexcept {
+    return iterator_at(tree_.template lower_bound<K>(key));
+  };
+
+  template <typename K = Key>
+  iterator upper_bound(const key_arg<K>& key) noexcept {
+    return iterator_at(tree_.template upper_bound<K>(key));
+  };
+
+  template <typename K = Key>
+  const_iterator upper_bound(const key_arg<K>& key) const noexcept {
+    return iterator_at(tree_.template upper_bound<K>(key));
+  };
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    std::vector<std::pair<iterator, bool>> result;
+    for (auto item : tree_.insert_many(false, std::forward<Args>(args)...))
+      result.push_back(iterator_at(item));
+    return result;
+  };
+
+ private:
+  iterator iterator_at(size_type index) noexcept {
+    return iterator(tree_.keys() + index, tree_.values() + index);
+  };
+
+  const_iterator iterator_at(size_type index) const noexcept {
+    return const_iterator(tree_.keys() + index, tree_.values() + index);
+  };
+
+  std::pair<iterator, bool> iterator_at(std::pair<size_type, bool> position) {
+    return {iterator_at(position.first), position.second};
+  };
+
+  size_type index_of(const_iterator pos) const noexcept {
+    return pos.key_ - tree_.keys();
+  };
+
+  // Random access over both columns at once. Dereferencing builds a pair of
+  // references, so operator-> hands out a pointer to one kept in a proxy.
+  template <bool Const>
+  class FlatMapIterator {
+    friend flat_map;
+    using mapped_pointer = std::conditional_t<Const, const T*, T*>;
+
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::pair<const Key, T>;
+    using difference_type = std::ptrdiff_t;
+    using reference =
+        std::pair<const Key&, std::conditional_t<Const, const T&, T&>>;
+
+    class pointer {
+     public:
+      const reference* operator->() const noexcept { return &ref_; };
+
+     private:
+      friend FlatMapIterator;
+      explicit pointer(reference ref) : ref_(ref){};
+      reference ref_;
+    };
+
+    FlatMapIterator() = default;
+
+    template <bool WasConst, typename = std::enable_if_t<Const && !WasConst>>
+    FlatMapIterator(const FlatMapIterator<WasConst>& other) noexcept
+        : key_(other.key_), value_(other.value_){};
+
+    reference operator*() const noexcept { return {*key_, *value_}; };
+
+    pointer operator->() const noexcept { return pointer(**this); };
+
+    reference operator[](difference_type n) const noexcept {
+      return *(*this + n);
+    };
+
+    FlatMapIterator& operator++() noexcept {
+      ++key_;
+      ++value_;
+      return *this;
+    };
+
+    FlatMapIterator operator++(int) noexcept {
+      FlatMapIterator old = *this;
+      ++*this;
+      return old;
+    };
+
+    FlatMapIterator& operator--() noexcept {
+      --key_;
+      --value_;
+      return *this;
+    };
+
+    FlatMapIterator operator--(int) noexcept {
+      FlatMapIterator old = *this;
+      --*this;
+      return old;
+    };
+
+    FlatMapIterator& operator+=(difference_type n) noexcept {
+      key_ += n;
+      value_ += n;
+      return *this;
+    };
+
+    FlatMapIterator& operator-=(difference_type n) noexcept {
+      return *this += -n;
+    };
+
+    FlatMapIterator operator+(difference_type n) const noexcept {
+      return FlatMapIterator(*this) += n;
+    };
+
+    FlatMapIterator operator-(difference_type n) const noexcept {
+      return FlatMapIterator(*this) -= n;
+    };
+
+    friend FlatMapIterator operator+(difference_type n,
+                                     const FlatMapIterator& it) noexcept {
+      return it + n;
+    };
+
+    // Non-members, so that an iterator and a const_iterator compare and
+    // subtract either way round: the iterator converts to the other.
+    friend difference_type operator-(const FlatMapIterator& a,
+                                     const FlatMapIterator& b) noexcept {
+      return a.key_ - b.key_;
+    };
+
+    friend bool operator==(const FlatMapIterator& a,
+                           const FlatMapIterator& b) noexcept {
+      return a.key_ == b.key_;
+    };
+
+    friend bool operator!=(const FlatMapIterator& a,
+                           const FlatMapIterator& b) noexcept {
+      return a.key_ != b.key_;
+    };
+
+    friend bool operator<(const FlatMapIterator& a,
+                          const FlatMapIterator& b) noexcept {
+      return a.key_ < b.key_;
+    };
+
+    friend bool operator>(const FlatMapIterator& a,
+                          const FlatMapIterator& b) noexcept {
+      return b.key_ < a.key_;
+    };
+
+    friend bool operator<=(const FlatMapIterator& a,
+                           const FlatMapIterator& b) noexcept {
+      return !(b.key_ < a.key_);
+    };
+
+    friend bool operator>=(const FlatMapIterator& a,
+                           const FlatMapIterator& b) noexcept {
+      return !(a.key_ < b.key_);
+    };
+
+   private:
+    template <bool>
+    friend class FlatMapIterator;
+
+    FlatMapIterator(const Key* key, mapped_pointer value) noexcept
+        : key_(key), value_(value){};
+
+    const Key* key_ = nullptr;
+    mapped_pointer value_ = nullptr;
+  };
+
+  tree tree_;
+};
+
+namespace pmr {
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using flat_map =
+    s21::flat_map<Key, T, Compare,
+                  std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_FLAT_MAP_H_
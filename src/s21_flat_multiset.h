@@ -0,0 +1,189 @@
+#ifndef SRC_S21_FLAT_MULTISET_H_
+#define SRC_S21_FLAT_MULTISET_H_
+
+#include <memory_resource>
+
+#include "s21_flat_tree.h"
+
+namespace s21 {
+// multiset over a sorted Vector, see flat_multiset. Equal values are kept in
+// insertion order.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class flat_multiset {
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using tree = FlatTree<value_type, void, Compare, Allocator>;
+  using size_type = std::size_t;
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
+
+ public:
+  using iterator = const value_type*;
+  using const_iterator = const value_type*;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using allocator_type = Allocator;
+
+  flat_multiset() : tree_(){};
+
+  explicit flat_multiset(const Compare& comp,
+                         const Allocator& alloc = Allocator())
+      : tree_(comp, alloc){};
+
+  explicit flat_multiset(const Allocator& alloc) : tree_(Compare(), alloc){};
+
+  flat_multiset(std::initializer_list<value_type> const& items,
+                const Compare& comp = Compare(),
+                const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.insert_range(items.begin(), items.end(), true);
+  };
+
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  flat_multiset(InputIt first, InputIt last, const Compare& comp = Compare(),
+                const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.insert_range(first, last, true);
+  };
+
+  flat_multiset(const flat_multiset& s) : tree_(s.tree_){};
+
+  flat_multiset(const flat_multiset& s, const Allocator& alloc)
+      : tree_(s.tree_, alloc){};
+
+  flat_multiset(flat_multiset&& s) : tree_(std::move(s.tree_)){};
+
+  ~flat_multiset() = default;
+
+  flat_multiset& operator=(const flat_multiset& other) {
+    tree_ = other.tree_;
+    return *this;
+  };
+
+  flat_multiset& operator=(flat_multiset&& other) {
+    tree_ = std::move(other.tree_);
+    return *this;
+  };
+
+  iterator insert(const_reference key) {
+    return begin() + tree_.insert_duplicate(key);
+  };
+
+  iterator insert(value_type&& key) {
+    return begin() + tree_.insert_duplicate(std::move(key));
+  };
+
+  iterator insert(const_iterator hint, const_reference value) {
+    return begin() + tree_.insert_hint_duplicate(hint - begin(), value);
+  };
+
+  // Sorts [first, last) and merges it in: O(n + m log m) for m new keys.
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  void insert(InputIt first, InputIt last) {
+    tree_.insert_range(first, last, true);
+  };
+
+  template <typename... Args>
+  iterator emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  };
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    size_type index = tree_.insert_hint_duplicate(
+        hint - begin(), value_type(std::forward<Args>(args)...));
+    return begin() + index;
+  };
+
+  size_type size() const noexcept { return tree_.size(); };
+
+  size_type max_size() const noexcept { return tree_.max_size(); };
+
+  size_type capacity() const noexcept { return tree_.capacity(); };
+
+  void reserve(size_type count) { tree_.reserve(count); };
+
+  void shrink_to_fit() { tree_.shrink_to_fit(); };
+
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
+  void erase(iterator pos) { tree_.erase(pos - begin()); };
+
+  bool empty() const noexcept { return tree_.empty(); };
+
+  void clear() { tree_.clear(); };
+
+  void swap(flat_multiset& other) { tree_.swap(other.tree_); };
+
+  void merge(flat_multiset& other) { tree_.merge(other.tree_, true); };
+
+  template <typename K = Key>
+  bool contains(const key_arg<K>& key) const {
+    return tree_.template find<K>(key) != size();
+  };
+
+  template <typename K = Key>
+  const_iterator find(const key_arg<K>& key) const {
+    return begin() + tree_.template find<K>(key);
+  };
+
+  template <typename K = Key>
+  size_type count(const key_arg<K>& key) const noexcept {
+    return tree_.template count<K>(key);
+  };
+
+  template <typename K = Key>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_arg<K>& key) const noexcept {
+    return {lower_bound<K>(key), upper_bound<K>(key)};
+  };
+
+  template <typename K = Key>
+  const_iterator lower_bound(const key_arg<K>& key) const noexcept {
+    return begin() + tree_.template lower_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  const_iterator upper_bound(const key_arg<K>& key) const noexcept {
+    return begin() + tree_.template upper_bound<K>(key);
+  };
+
+  const_iterator begin() const noexcept { return tree_.keys(); };
+
+  const_iterator end() const noexcept { return tree_.keys() + tree_.size(); };
+
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  value_compare value_comp() const { return tree_.key_comp(); };
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    std::vector<std::pair<iterator, bool>> result;
+    for (auto item : tree_.insert_many(true, std::forward<Args>(args)...))
+      result.push_back(at(item));
+    return result;
+  };
+
+ private:
+  std::pair<iterator, bool> at(std::pair<size_type, bool> position) const {
+    return {begin() + position.first, position.second};
+  };
+
+  tree tree_;
+};
+
+namespace pmr {
+template <typename Key, typename Compare = std::less<Key>>
+using flat_multiset =
+    s21::flat_multiset<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_FLAT_MULTISET_H_
@@ -0,0 +1,194 @@
+#ifndef SRC_S21_FLAT_SET_H_
+#define SRC_S21_FLAT_SET_H_
+
+#include <memory_resource>
+
+#include "s21_flat_tree.h"
+
+namespace s21 {
+// set over a sorted Vector: the interface of s21::set for everything that
+// does not depend on nodes, for sets that are built once and then read many
+// times. Lookups are binary searches over contiguous keys; a single insert
+// or erase shifts every key after it, so fill it through the range
+// constructor or insert(first, last). Any insert or erase invalidates every
+// iterator.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class flat_set {
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using tree = FlatTree<value_type, void, Compare, Allocator>;
+  using size_type = std::size_t;
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
+
+ public:
+  using iterator = const value_type*;
+  using const_iterator = const value_type*;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using allocator_type = Allocator;
+
+  flat_set() : tree_(){};
+
+  explicit flat_set(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_(comp, alloc){};
+
+  explicit flat_set(const Allocator& alloc) : tree_(Compare(), alloc){};
+
+  flat_set(std::initializer_list<value_type> const& items,
+           const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.insert_range(items.begin(), items.end(), false);
+  };
+
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  flat_set(InputIt first, InputIt last, const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.insert_range(first, last, false);
+  };
+
+  flat_set(const flat_set& s) : tree_(s.tree_){};
+
+  flat_set(const flat_set& s, const Allocator& alloc)
+      : tree_(s.tree_, alloc){};
+
+  flat_set(flat_set&& s) : tree_(std::move(s.tree_)){};
+
+  ~flat_set() = default;
+
+  flat_set& operator=(const flat_set& other) {
+    tree_ = other.tree_;
+    return *this;
+  };
+
+  flat_set& operator=(flat_set&& other) {
+    tree_ = std::move(other.tree_);
+    return *this;
+  };
+
+  std::pair<iterator, bool> insert(const_reference key) {
+    return at(tree_.insert(key));
+  };
+
+  std::pair<iterator, bool> insert(value_type&& key) {
+    return at(tree_.insert(std::move(key)));
+  };
+
+  iterator insert(const_iterator hint, const_reference value) {
+    return at(tree_.insert_hint(hint - begin(), value)).first;
+  };
+
+  // Sorts [first, last) and merges it in: O(n + m log m) for m new keys.
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  void insert(InputIt first, InputIt last) {
+    tree_.insert_range(first, last, false);
+  };
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  };
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return at(tree_.insert_hint(hint - begin(),
+                                value_type(std::forward<Args>(args)...)))
+        .first;
+  };
+
+  size_type size() const noexcept { return tree_.size(); };
+
+  size_type max_size() const noexcept { return tree_.max_size(); };
+
+  size_type capacity() const noexcept { return tree_.capacity(); };
+
+  void reserve(size_type count) { tree_.reserve(count); };
+
+  void shrink_to_fit() { tree_.shrink_to_fit(); };
+
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
+  void erase(iterator pos) { tree_.erase(pos - begin()); };
+
+  bool empty() const noexcept { return tree_.empty(); };
+
+  void clear() { tree_.clear(); };
+
+  void swap(flat_set& other) { tree_.swap(other.tree_); };
+
+  void merge(flat_set& other) { tree_.merge(other.tree_, false); };
+
+  template <typename K = Key>
+  bool contains(const key_arg<K>& key) const {
+    return tree_.template find<K>(key) != size();
+  };
+
+  template <typename K = Key>
+  const_iterator find(const key_arg<K>& key) const {
+    return begin() + tree_.template find<K>(key);
+  };
+
+  template <typename K = Key>
+  size_type count(const key_arg<K>& key) const noexcept {
+    return contains<K>(key) ? 1 : 0;
+  };
+
+  template <typename K = Key>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_arg<K>& key) const noexcept {
+    const_iterator first = lower_bound<K>(key);
+    if (first == end() || key_comp()(key, *first)) return {first, first};
+    return {first, first + 1};
+  };
+
+  template <typename K = Key>
+  const_iterator lower_bound(const key_arg<K>& key) const noexcept {
+    return begin() + tree_.template lower_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  const_iterator upper_bound(const key_arg<K>& key) const noexcept {
+    return begin() + tree_.template upper_bound<K>(key);
+  };
+
+  const_iterator begin() const noexcept { return tree_.keys(); };
+
+  const_iterator end() const noexcept { return tree_.keys() + tree_.size(); };
+
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  value_compare value_comp() const { return tree_.key_comp(); };
+
+  template <typename... Args>
+  std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
+    std::vector<std::pair<iterator, bool>> result;
+    for (auto item : tree_.insert_many(false, std::forward<Args>(args)...))
+      result.push_back(at(item));
+    return result;
+  };
+
+ private:
+  std::pair<iterator, bool> at(std::pair<size_type, bool> position) const {
+    return {begin() + position.first, position.second};
+  };
+
+  tree tree_;
+};
+
+namespace pmr {
+template <typename Key, typename Compare = std::less<Key>>
+using flat_set =
+    s21::flat_set<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_FLAT_SET_H_
@@ -0,0 +1,345 @@
+#ifndef SRC_S21_FLAT_TREE_H_
+#define SRC_S21_FLAT_TREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_compare.h"
+#include "s21_vector.h"
+
+namespace s21 {
+// Column of mapped values that a FlatTree keeps next to its keys, the value
+// of the key at index i at index i. Sets have no such column, and the empty
+// specialization adds nothing to their size.
+template <typename Mapped, typename Allocator>
+class FlatValues {
+ protected:
+  using mapped_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Mapped>;
+
+  FlatValues() = default;
+  explicit FlatValues(const Allocator& alloc)
+      : values_(mapped_allocator(alloc)){};
+
+  Vector<Mapped, mapped_allocator> values_;
+};
+
+template <typename Allocator>
+class FlatValues<void, Allocator> {
+ protected:
+  FlatValues() = default;
+  explicit FlatValues(const Allocator&){};
+};
+
+// Sorted array behind flat_set, flat_multiset and flat_map: the keys in one
+// Vector ordered by Compare and, unless Mapped is void, the mapped values in
+// a second Vector at the same indices. A lookup is a binary search over the
+// keys alone, which touches a few cache lines of contiguous keys instead of
+// one node per level. Inserting or erasing one element shifts the tail of
+// both columns, so batches go through insert_range, which sorts the batch
+// on its own and merges it with the elements in one pass.
+//
+// Positions are indices; the containers turn them into iterators. Any
+// insert or erase invalidates every iterator and reference.
+template <typename Key, typename Mapped, typename Compare, typename Allocator>
+class FlatTree : private CompareStorage<Compare>,
+                 private FlatValues<Mapped, Allocator> {
+  using compare_storage = CompareStorage<Compare>;
+  using values_base = FlatValues<Mapped, Allocator>;
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using key_allocator = typename alloc_traits::template rebind_alloc<Key>;
+  using index_allocator =
+      typename alloc_traits::template rebind_alloc<std::size_t>;
+
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
+
+  static constexpr bool kHasValues = !std::is_void<Mapped>::value;
+
+ public:
+  using key_type = Key;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using size_type = std::size_t;
+
+  FlatTree() = default;
+
+  explicit FlatTree(const Compare& comp, const Allocator& alloc = Allocator())
+      : compare_storage(comp),
+        values_base(alloc),
+        keys_(key_allocator(alloc)){};
+
+  FlatTree(const FlatTree& other) = default;
+
+  FlatTree(const FlatTree& other, const Allocator& alloc)
+      : FlatTree(other.key_comp(), alloc) {
+    reserve(other.size());
+    for (size_type i = 0; i < other.size(); ++i) append(other, i);
+  };
+
+  FlatTree(FlatTree&& other) = default;
+
+  FlatTree& operator=(const FlatTree& other) = default;
+
+  FlatTree& operator=(FlatTree&& other) = default;
+
+  const Key* keys() const noexcept { return keys_.cbegin(); };
+
+  auto values() noexcept { return this->values_.data(); };
+
+  auto values() const noexcept { return this->values_.cbegin(); };
+
+  key_compare key_comp() const { return compare_storage::get(); };
+
+  allocator_type get_allocator() const noexcept {
+    return allocator_type(keys_.get_allocator());
+  };
+
+  bool empty() const noexcept { return keys_.empty(); };
+
+  size_type size() const noexcept { return keys_.size(); };
+
+  size_type max_size() const noexcept { return keys_.max_size(); };
+
+  size_type capacity() const noexcept { return keys_.capacity(); };
+
+  void reserve(size_type count) {
+    keys_.reserve(count);
+    if constexpr (kHasValues) this->values_.reserve(count);
+  };
+
+  void shrink_to_fit() {
+    keys_.shrink_to_fit();
+    if constexpr (kHasValues) this->values_.shrink_to_fit();
+  };
+
+  void clear() noexcept {
+    keys_.clear();
+    if constexpr (kHasValues) this->values_.clear();
+  };
+
+  void swap(FlatTree& other) {
+    compare_storage::swap(other);
+    keys_.swap(other.keys_);
+    if constexpr (kHasValues) this->values_.swap(other.values_);
+  };
+
+  template <typename K = Key>
+  size_type lower_bound(const key_arg<K>& key) const {
+    return std::lower_bound(keys_.cbegin(), keys_.cend(), key, key_comp()) -
+           keys_.cbegin();
+  };
+
+  template <typename K = Key>
+  size_type upper_bound(const key_arg<K>& key) const {
+    return std::upper_bound(keys_.cbegin(), keys_.cend(), key, key_comp()) -
+           keys_.cbegin();
+  };
+
+  // index of the first key equivalent to key, or size()
+  template <typename K = Key>
+  size_type find(const key_arg<K>& key) const {
+    size_type index = lower_bound<K>(key);
+    if (index != size() && key_comp()(key, keys_[index])) return size();
+    return index;
+  };
+
+  template <typename K = Key>
+  size_type count(const key_arg<K>& key) const {
+    return upper_bound<K>(key) - lower_bound<K>(key);
+  };
+
+  // Inserts key, with a mapped value built from args, unless an equivalent
+  // key is already there. Returns the index of the key either way.
+  template <typename KeyArg, typename... Args>
+  std::pair<size_type, bool> insert(KeyArg&& key, Args&&... args) {
+    size_type index = lower_bound(key);
+    if (index != size() && !key_comp()(key, keys_[index]))
+      return {index, false};
+    insert_at(index, std::forward<KeyArg>(key), std::forward<Args>(args)...);
+    return {index, true};
+  };
+
+  // Inserts key after all equivalent keys.
+  template <typename KeyArg, typename... Args>
+  size_type insert_duplicate(KeyArg&& key, Args&&... args) {
+    size_type index = upper_bound(key);
+    insert_at(index, std::forward<KeyArg>(key), std::forward<Args>(args)...);
+    return index;
+  };
+
+  // insert() that skips the search when key belongs right before hint.
+  template <typename KeyArg, typename... Args>
+  std::pair<size_type, bool> insert_hint(size_type hint, KeyArg&& key,
+                                         Args&&... args) {
+    if ((hint == 0 || key_comp()(keys_[hint - 1], key)) &&
+        (hint == size() || key_comp()(key, keys_[hint]))) {
+      insert_at(hint, std::forward<KeyArg>(key), std::forward<Args>(args)...);
+      return {hint, true};
+    }
+    return insert(std::forward<KeyArg>(key), std::forward<Args>(args)...);
+  };
+
+  template <typename KeyArg, typename... Args>
+  size_type insert_hint_duplicate(size_type hint, KeyArg&& key,
+                                  Args&&... args) {
+    if ((hint == 0 || !key_comp()(key, keys_[hint - 1])) &&
+        (hint == size() || !key_comp()(keys_[hint], key))) {
+      insert_at(hint, std::forward<KeyArg>(key), std::forward<Args>(args)...);
+      return hint;
+    }
+    return insert_duplicate(std::forward<KeyArg>(key),
+                            std::forward<Args>(args)...);
+  };
+
+  // Each insert shifts the elements after it, so the indices returned
+  // before it are moved along.
+  template <typename... Items>
+  std::vector<std::pair<size_type, bool>> insert_many(bool duplicates,
+                                                      Items&&... items) {
+    std::vector<std::pair<size_type, bool>> result;
+    result.reserve(sizeof...(items));
+    (result.push_back(insert_item(std::forward<Items>(items), duplicates)),
+     ...);
+    for (size_type i = 0; i < result.size(); ++i) {
+      if (!result[i].second) continue;
+      for (size_type j = 0; j < i; ++j)
+        if (result[j].first >= result[i].first) result[j].first++;
+    }
+    return result;
+  };
+
+  // Adds the keys, or key-value pairs, of [first, last): the batch is sorted
+  // on its own in O(m log m) and merged with the n elements in one O(n + m)
+  // pass instead of shifting the tail once per element. Without duplicates
+  // the first of equivalent keys wins, and the ones already here win over
+  // the batch.
+  template <typename InputIt>
+  void insert_range(InputIt first, InputIt last, bool duplicates) {
+    FlatTree batch(key_comp(), get_allocator());
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value)
+      batch.reserve(std::distance(first, last));
+    for (; first != last; ++first) batch.append_item(*first);
+    batch.sort();
+    merge(batch, duplicates);
+  };
+
+  // Moves the elements of other here in one pass over both. Without
+  // duplicates the keys already here stay and the equivalent ones are left
+  // in other; with them equivalent keys of other go after those here.
+  void merge(FlatTree& other, bool duplicates) {
+    if (this == &other || other.empty()) return;
+    FlatTree merged(key_comp(), get_allocator());
+    FlatTree rest(other.key_comp(), other.get_allocator());
+    merged.reserve(size() + other.size());
+    size_type i = 0;
+    for (size_type j = 0; j < other.size();) {
+      if (i < size() && !key_comp()(other.keys_[j], keys_[i])) {
+        merged.append(std::move(*this), i++);
+      } else if (!duplicates && !merged.empty() &&
+                 !key_comp()(merged.keys_.back(), other.keys_[j])) {
+        rest.append(std::move(other), j++);
+      } else {
+        merged.append(std::move(other), j++);
+      }
+    }
+    for (; i < size(); ++i) merged.append(std::move(*this), i);
+    swap(merged);
+    other.swap(rest);
+  };
+
+  void erase(size_type index) {
+    keys_.erase(keys_.begin() + index);
+    if constexpr (kHasValues)
+      this->values_.erase(this->values_.begin() + index);
+  };
+
+ private:
+  template <typename KeyArg, typename... Args>
+  void insert_at(size_type index, KeyArg&& key, Args&&... args) {
+    keys_.emplace(keys_.cbegin() + index, std::forward<KeyArg>(key));
+    if constexpr (kHasValues) {
+      try {
+        this->values_.emplace(this->values_.cbegin() + index,
+                              std::forward<Args>(args)...);
+      } catch (...) {
+        keys_.erase(keys_.begin() + index);
+        throw;
+      }
+    }
+  };
+
+  // Items are keys, or key-value pairs when there are values.
+  template <typename Item>
+  std::pair<size_type, bool> insert_item(Item&& item, bool duplicates) {
+    if constexpr (kHasValues) {
+      if (duplicates)
+        return {insert_duplicate(std::forward<Item>(item).first,
+                                 std::forward<Item>(item).second),
+                true};
+      return insert(std::forward<Item>(item).first,
+                    std::forward<Item>(item).second);
+    } else {
+      if (duplicates)
+        return {insert_duplicate(std::forward<Item>(item)), true};
+      return insert(std::forward<Item>(item));
+    }
+  };
+
+  // Adds an item past the last key without keeping the order; only sort()
+  // may follow.
+  template <typename Item>
+  void append_item(Item&& item) {
+    if constexpr (kHasValues) {
+      keys_.emplace_back(std::forward<Item>(item).first);
+      this->values_.emplace_back(std::forward<Item>(item).second);
+    } else {
+      keys_.emplace_back(std::forward<Item>(item));
+    }
+  };
+
+  void append(const FlatTree& from, size_type index) {
+    keys_.emplace_back(from.keys_[index]);
+    if constexpr (kHasValues) this->values_.emplace_back(from.values_[index]);
+  };
+
+  void append(FlatTree&& from, size_type index) {
+    keys_.emplace_back(std::move(from.keys_[index]));
+    if constexpr (kHasValues)
+      this->values_.emplace_back(std::move(from.values_[index]));
+  };
+
+  // Stable, so that equivalent keys keep the order they came in. Keys alone
+  // are sorted in place; with values a permutation of the indices is sorted
+  // and both columns are gathered through it.
+  void sort() {
+    Compare comp = key_comp();
+    if constexpr (!kHasValues) {
+      std::stable_sort(keys_.data(), keys_.data() + size(), comp);
+    } else {
+      Vector<size_type, index_allocator> order(
+          size(), index_allocator(keys_.get_allocator()));
+      for (size_type i = 0; i < size(); ++i) order[i] = i;
+      std::stable_sort(order.data(), order.data() + size(),
+                       [&](size_type a, size_type b) {
+                         return comp(keys_[a], keys_[b]);
+                       });
+      FlatTree sorted(comp, get_allocator());
+      sorted.reserve(size());
+      for (size_type i = 0; i < size(); ++i)
+        sorted.append(std::move(*this), order[i]);
+      swap(sorted);
+    }
+  };
+
+  Vector<Key, key_allocator> keys_;
+};
+}  // namespace s21
+
+#endif  // SRC_S21_FLAT_TREE_H_
@@ -0,0 +1,141 @@
+#ifndef SRC_S21_FROZEN_MAP_H_
+#define SRC_S21_FROZEN_MAP_H_
+
+#include <memory_resource>
+#include <stdexcept>
+
+#include "s21_compare.h"
+#include "s21_frozen_tree.h"
+
+namespace s21 {
+// Only named by the constructor that freezes one; see s21_map.h.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          bool OrderStatistics, typename Storage>
+class map;
+
+// Read-only map made from a s21::map, see frozen_set. The mapped values
+// follow the keys in the same allocation and Eytzinger order, so iterators
+// yield a std::pair<const Key&, const T&> rather than a stored pair.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class frozen_map {
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using tree = FrozenTree<Key, T, Compare, Allocator>;
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
+
+ public:
+  using key_compare = Compare;
+  using value_compare = PairKeyCompare<Key, T, Compare>;
+  using iterator = typename tree::iterator;
+  using const_iterator = typename tree::iterator;
+  using allocator_type = Allocator;
+
+  frozen_map() = default;
+
+  template <typename MapAllocator, bool OrderStatistics, typename Storage>
+  explicit frozen_map(
+      const map<Key, T, Compare, MapAllocator, OrderStatistics, Storage>&
+          source,
+      const Allocator& alloc = Allocator())
+      : tree_(source.begin(), source.size(), source.key_comp(), alloc){};
+
+  frozen_map(std::initializer_list<value_type> const& items,
+             const Compare& comp = Compare(),
+             const Allocator& alloc = Allocator())
+      : tree_(items, comp, alloc){};
+
+  frozen_map(const frozen_map& m) : tree_(m.tree_){};
+
+  frozen_map(const frozen_map& m, const Allocator& alloc)
+      : tree_(m.tree_, alloc){};
+
+  frozen_map(frozen_map&& m) : tree_(std::move(m.tree_)){};
+
+  ~frozen_map() = default;
+
+  frozen_map& operator=(const frozen_map& m) {
+    tree_ = m.tree_;
+    return *this;
+  };
+
+  frozen_map& operator=(frozen_map&& m) {
+    tree_ = std::move(m.tree_);
+    return *this;
+  };
+
+  const T& at(const Key& key) const {
+    const_iterator it = tree_.find(key);
+    if (it == tree_.end()) throw std::out_of_range("frozen_map::at");
+    return (*it).second;
+  };
+
+  const_iterator begin() const noexcept { return tree_.begin(); };
+
+  const_iterator end() const noexcept { return tree_.end(); };
+
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  value_compare value_comp() const { return value_compare(key_comp()); };
+
+  bool empty() const noexcept { return tree_.empty(); };
+
+  size_type size() const noexcept { return tree_.size(); };
+
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
+  void swap(frozen_map& other) noexcept { tree_.swap(other.tree_); };
+
+  template <typename K = Key>
+  bool contains(const key_arg<K>& key) const {
+    return tree_.template contains<K>(key);
+  };
+
+  template <typename K = Key>
+  const_iterator find(const key_arg<K>& key) const {
+    return tree_.template find<K>(key);
+  };
+
+  template <typename K = Key>
+  size_type count(const key_arg<K>& key) const {
+    return tree_.template contains<K>(key) ? 1 : 0;
+  };
+
+  template <typename K = Key>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_arg<K>& key) const {
+    const_iterator first = tree_.template lower_bound<K>(key);
+    if (first == end() || key_comp()(key, (*first).first))
+      return {first, first};
+    const_iterator last = first;
+    return {first, ++last};
+  };
+
+  template <typename K = Key>
+  const_iterator lower_bound(const key_arg<K>& key) const {
+    return tree_.template lower_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  const_iterator upper_bound(const key_arg<K>& key) const {
+    return tree_.template upper_bound<K>(key);
+  };
+
+ private:
+  tree tree_;
+};
+
+namespace pmr {
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using frozen_map =
+    s21::frozen_map<Key, T, Compare,
+                    std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_FROZEN_MAP_H_
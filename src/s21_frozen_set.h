@@ -0,0 +1,130 @@
+#ifndef SRC_S21_FROZEN_SET_H_
+#define SRC_S21_FROZEN_SET_H_
+
+#include <memory_resource>
+
+#include "s21_frozen_tree.h"
+
+namespace s21 {
+// Only named by the constructor that freezes one; see s21_set.h.
+template <typename Key, typename Compare, typename Allocator,
+          bool OrderStatistics, typename Storage>
+class set;
+
+// Read-only set for lookup tables built once at startup. It is made from a
+// s21::set or a list of keys, which it copies into one allocation in
+// Eytzinger order (see FrozenTree), and answers find/contains/bounds with a
+// branchless search. Nothing can be inserted or erased afterwards.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class frozen_set {
+  using key_type = Key;
+  using value_type = Key;
+  using tree = FrozenTree<Key, void, Compare, Allocator>;
+  using size_type = std::size_t;
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
+
+ public:
+  using iterator = typename tree::iterator;
+  using const_iterator = typename tree::iterator;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using allocator_type = Allocator;
+
+  frozen_set() = default;
+
+  template <typename SetAllocator, bool OrderStatistics, typename Storage>
+  explicit frozen_set(
+      const set<Key, Compare, SetAllocator, OrderStatistics, Storage>& source,
+      const Allocator& alloc = Allocator())
+      : tree_(source.begin(), source.size(), source.key_comp(), alloc){};
+
+  frozen_set(std::initializer_list<value_type> const& items,
+             const Compare& comp = Compare(),
+             const Allocator& alloc = Allocator())
+      : tree_(items, comp, alloc){};
+
+  frozen_set(const frozen_set& s) : tree_(s.tree_){};
+
+  frozen_set(const frozen_set& s, const Allocator& alloc)
+      : tree_(s.tree_, alloc){};
+
+  frozen_set(frozen_set&& s) : tree_(std::move(s.tree_)){};
+
+  ~frozen_set() = default;
+
+  frozen_set& operator=(const frozen_set& other) {
+    tree_ = other.tree_;
+    return *this;
+  };
+
+  frozen_set& operator=(frozen_set&& other) {
+    tree_ = std::move(other.tree_);
+    return *this;
+  };
+
+  const_iterator begin() const noexcept { return tree_.begin(); };
+
+  const_iterator end() const noexcept { return tree_.end(); };
+
+  bool empty() const noexcept { return tree_.empty(); };
+
+  size_type size() const noexcept { return tree_.size(); };
+
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  value_compare value_comp() const { return tree_.key_comp(); };
+
+  void swap(frozen_set& other) noexcept { tree_.swap(other.tree_); };
+
+  template <typename K = Key>
+  bool contains(const key_arg<K>& key) const {
+    return tree_.template contains<K>(key);
+  };
+
+  template <typename K = Key>
+  const_iterator find(const key_arg<K>& key) const {
+    return tree_.template find<K>(key);
+  };
+
+  template <typename K = Key>
+  size_type count(const key_arg<K>& key) const {
+    return tree_.template contains<K>(key) ? 1 : 0;
+  };
+
+  template <typename K = Key>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_arg<K>& key) const {
+    const_iterator first = tree_.template lower_bound<K>(key);
+    if (first == end() || key_comp()(key, *first)) return {first, first};
+    const_iterator last = first;
+    return {first, ++last};
+  };
+
+  template <typename K = Key>
+  const_iterator lower_bound(const key_arg<K>& key) const {
+    return tree_.template lower_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  const_iterator upper_bound(const key_arg<K>& key) const {
+    return tree_.template upper_bound<K>(key);
+  };
+
+ private:
+  tree tree_;
+};
+
+namespace pmr {
+template <typename Key, typename Compare = std::less<Key>>
+using frozen_set =
+    s21::frozen_set<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+}  // namespace s21
+
+#endif  // SRC_S21_FROZEN_SET_H_
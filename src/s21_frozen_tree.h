@@ -0,0 +1,475 @@
+#ifndef SRC_S21_FROZEN_TREE_H_
+#define SRC_S21_FROZEN_TREE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_compare.h"
+
+namespace s21 {
+// Read-only search tree behind frozen_set and frozen_map. The n keys are
+// stored in Eytzinger order: a complete binary search tree laid out level
+// by level, the root at index 1 and the children of k at 2k and 2k + 1, so
+// the tree is implicit and every key of a level lies next to the others.
+// A search walks down with k = 2k + (key[k] < x), which compiles to a
+// conditional add instead of a branch, and prefetches the cache line that
+// holds the descendants of k a few levels below while it compares. Unless
+// Mapped is void, the mapped values follow the keys in the same order.
+// Keys and values share one allocation, aligned to a cache line.
+//
+// Index 0 is never used for a key and stands for end(). Iteration is in
+// key order, each step going to the in-order successor in the implicit
+// tree.
+template <typename Key, typename Mapped, typename Compare, typename Allocator>
+class FrozenTree : private CompareStorage<Compare> {
+  class FrozenTreeIterator;
+
+  using compare_storage = CompareStorage<Compare>;
+  using size_type = std::size_t;
+
+  static constexpr bool kHasValues = !std::is_void<Mapped>::value;
+  using mapped_type = std::conditional_t<kHasValues, Mapped, char>;
+  // What the tree is built from: a key, or a key-value pair.
+  using item_type =
+      std::conditional_t<kHasValues, std::pair<const Key, mapped_type>, Key>;
+
+  static constexpr size_type kCacheLine = 64;
+  // Block of raw storage the allocation is made of; its alignment puts key
+  // index 0 at the start of a cache line, and with it every group of
+  // kPrefetchStride siblings.
+  struct alignas(kCacheLine) Block {
+    unsigned char bytes[kCacheLine];
+  };
+
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using block_allocator = typename alloc_traits::template rebind_alloc<Block>;
+  using block_traits = std::allocator_traits<block_allocator>;
+  using key_allocator = typename alloc_traits::template rebind_alloc<Key>;
+  using mapped_allocator =
+      typename alloc_traits::template rebind_alloc<mapped_type>;
+
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
+
+  // The descendants of k that are log2(stride) levels below it are the
+  // stride keys from index k * stride, one cache line for small keys.
+  static constexpr size_type kPrefetchStride =
+      std::max<size_type>(kCacheLine / sizeof(Key), 4);
+  static constexpr bool kBitwise =
+      std::is_trivially_copyable<Key>::value &&
+      std::is_trivially_copyable<mapped_type>::value;
+
+ public:
+  using key_type = Key;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using iterator = FrozenTreeIterator;
+
+  FrozenTree() = default;
+
+  // Builds the tree from size sorted, unique items: keys, or key-value
+  // pairs when there are values. The items are placed in an in-order walk
+  // of the implicit tree.
+  template <typename InputIt>
+  FrozenTree(InputIt first, size_type size, const Compare& comp,
+             const Allocator& alloc)
+      : compare_storage(comp), alloc_(alloc) {
+    build(first, size, [](const auto& item) -> const auto& { return item; });
+  };
+
+  // Builds the tree from items in any order, keeping the first of equal
+  // keys. Only pointers to the items are sorted.
+  FrozenTree(std::initializer_list<item_type> items, const Compare& comp,
+             const Allocator& alloc)
+      : compare_storage(comp), alloc_(alloc) {
+    const Compare& less = compare_storage::get();
+    std::vector<const item_type*> order;
+    order.reserve(items.size());
+    for (const item_type& item : items) order.push_back(&item);
+    std::stable_sort(order.begin(), order.end(),
+                     [&less](const item_type* a, const item_type* b) {
+                       return less(key_of(*a), key_of(*b));
+                     });
+    auto last = std::unique(order.begin(), order.end(),
+                            [&less](const item_type* a, const item_type* b) {
+                              return !less(key_of(*a), key_of(*b));
+                            });
+    build(order.begin(), last - order.begin(),
+          [](const item_type* item) -> const item_type& { return *item; });
+  };
+
+  FrozenTree(const FrozenTree& other)
+      : FrozenTree(other, alloc_traits::select_on_container_copy_construction(
+                              other.alloc_)){};
+
+  FrozenTree(const FrozenTree& other, const Allocator& alloc)
+      : compare_storage(other), alloc_(alloc) {
+    allocate(other.size_);
+    if constexpr (kBitwise) {
+      if (size_)
+        std::memcpy(blocks_, other.blocks_, blocks_size() * sizeof(Block));
+    } else {
+      size_type built = 0;
+      size_type index = size_ ? leftmost(1) : 0;
+      try {
+        for (; built < size_; ++built, index = successor(index)) {
+          if constexpr (kHasValues)
+            construct(index, other.keys()[index], other.values()[index]);
+          else
+            construct(index, other.keys()[index], mapped_type());
+        }
+      } catch (...) {
+        destroy(built);
+        deallocate();
+        throw;
+      }
+    }
+  };
+
+  FrozenTree(FrozenTree&& other) noexcept
+      : compare_storage(other), alloc_(other.alloc_) {
+    steal(other);
+  };
+
+  ~FrozenTree() {
+    destroy(size_);
+    deallocate();
+  };
+
+  FrozenTree& operator=(const FrozenTree& other) {
+    if (this == &other) return *this;
+    if constexpr (alloc_traits::is_always_equal::value) {
+      FrozenTree copy(other);
+      swap(copy);
+    } else {
+      FrozenTree copy(other, alloc_);
+      swap(copy);
+    }
+    return *this;
+  };
+
+  // Takes over the storage of other unless it belongs to an allocator that
+  // cannot free it here; then the elements are copied.
+  FrozenTree& operator=(FrozenTree&& other) {
+    if (this == &other) return *this;
+    constexpr bool steal_always =
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value;
+    if constexpr (!steal_always) {
+      if (alloc_ != other.alloc_) return *this = other;
+    }
+    destroy(size_);
+    deallocate();
+    compare_storage::operator=(other);
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+      alloc_ = std::move(other.alloc_);
+    steal(other);
+    return *this;
+  };
+
+  iterator begin() const noexcept {
+    return iterator(this, size_ ? leftmost(1) : 0);
+  };
+
+  iterator end() const noexcept { return iterator(this, 0); };
+
+  key_compare key_comp() const { return compare_storage::get(); };
+
+  allocator_type get_allocator() const noexcept { return alloc_; };
+
+  bool empty() const noexcept { return size_ == 0; };
+
+  size_type size() const noexcept { return size_; };
+
+  void swap(FrozenTree& other) noexcept {
+    compare_storage::swap(other);
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(alloc_, other.alloc_);
+    }
+    std::swap(blocks_, other.blocks_);
+    std::swap(size_, other.size_);
+  };
+
+  template <typename K = Key>
+  iterator lower_bound(const key_arg<K>& key) const {
+    return iterator(this, descend(key, [this](const Key& node, const auto& x) {
+                      return key_comp()(node, x);
+                    }));
+  };
+
+  template <typename K = Key>
+  iterator upper_bound(const key_arg<K>& key) const {
+    return iterator(this, descend(key, [this](const Key& node, const auto& x) {
+                      return !key_comp()(x, node);
+                    }));
+  };
+
+  template <typename K = Key>
+  iterator find(const key_arg<K>& key) const {
+    iterator it = lower_bound<K>(key);
+    if (it.index_ && key_comp()(key, keys()[it.index_])) return end();
+    return it;
+  };
+
+  template <typename K = Key>
+  bool contains(const key_arg<K>& key) const {
+    return find<K>(key).index_ != 0;
+  };
+
+ private:
+  using key_traits = std::allocator_traits<key_allocator>;
+  using mapped_traits = std::allocator_traits<mapped_allocator>;
+
+  // Index of the first key for which go_right is false, 0 if there is none.
+  // Every right turn appends a one bit to k and every left turn a zero, so
+  // the answer is the node of the last left turn: k without its trailing
+  // ones and the zero before them.
+  template <typename K, typename GoRight>
+  size_type descend(const K& key, GoRight go_right) const {
+    const Key* nodes = keys();
+    size_type k = 1;
+    while (k <= size_) {
+      prefetch(nodes + std::min(k * kPrefetchStride, size_));
+      k = 2 * k + go_right(nodes[k], key);
+    }
+    return k >> (trailing_ones(k) + 1);
+  };
+
+  static void prefetch([[maybe_unused]] const void* address) noexcept {
+#if defined(__GNUC__)
+    __builtin_prefetch(address);
+#endif
+  };
+
+  static size_type trailing_ones(size_type k) noexcept {
+#if defined(__GNUC__)
+    return static_cast<size_type>(__builtin_ctzll(~k));
+#else
+    size_type ones = 0;
+    for (; k & 1; k >>= 1) ++ones;
+    return ones;
+#endif
+  };
+
+  size_type leftmost(size_type k) const noexcept {
+    while (2 * k <= size_) k *= 2;
+    return k;
+  };
+
+  size_type rightmost(size_type k) const noexcept {
+    while (2 * k + 1 <= size_) k = 2 * k + 1;
+    return k;
+  };
+
+  // in-order neighbours; 0 is end() and comes after the last key and
+  // before the first one
+  size_type successor(size_type k) const noexcept {
+    if (k == 0) return size_ ? leftmost(1) : 0;
+    if (2 * k + 1 <= size_) return leftmost(2 * k + 1);
+    return k >> (trailing_ones(k) + 1);
+  };
+
+  size_type predecessor(size_type k) const noexcept {
+    if (k == 0) return size_ ? rightmost(1) : 0;
+    if (2 * k <= size_) return rightmost(2 * k);
+    while (k && !(k & 1)) k >>= 1;
+    return k >> 1;
+  };
+
+  // Keys take indices 0 to size_ and the values the same indices of the
+  // array after them.
+  size_type keys_bytes() const noexcept {
+    size_type bytes = (size_ + 1) * sizeof(Key);
+    return (bytes + alignof(mapped_type) - 1) / alignof(mapped_type) *
+           alignof(mapped_type);
+  };
+
+  size_type blocks_size() const noexcept {
+    size_type bytes = keys_bytes();
+    if constexpr (kHasValues) bytes += (size_ + 1) * sizeof(mapped_type);
+    return (bytes + sizeof(Block) - 1) / sizeof(Block);
+  };
+
+  Key* keys() const noexcept { return reinterpret_cast<Key*>(blocks_); };
+
+  mapped_type* values() const noexcept {
+    return reinterpret_cast<mapped_type*>(
+        reinterpret_cast<unsigned char*>(blocks_) + keys_bytes());
+  };
+
+  void allocate(size_type size) {
+    size_ = size;
+    if (size_ == 0) return;
+    block_allocator blocks(alloc_);
+    blocks_ = block_traits::allocate(blocks, blocks_size());
+  };
+
+  void deallocate() noexcept {
+    if (blocks_) {
+      block_allocator blocks(alloc_);
+      block_traits::deallocate(blocks, blocks_, blocks_size());
+    }
+    blocks_ = nullptr;
+    size_ = 0;
+  };
+
+  static const Key& key_of(const item_type& item) noexcept {
+    if constexpr (kHasValues)
+      return item.first;
+    else
+      return item;
+  };
+
+  // Places size items from first, read through item_of, in an in-order
+  // walk of the implicit tree.
+  template <typename InputIt, typename ItemOf>
+  void build(InputIt first, size_type size, ItemOf item_of) {
+    allocate(size);
+    size_type index = size ? leftmost(1) : 0;
+    size_type built = 0;
+    try {
+      for (; built < size; ++built, ++first, index = successor(index))
+        construct(index, item_of(*first));
+    } catch (...) {
+      destroy(built);
+      deallocate();
+      throw;
+    }
+  };
+
+  template <typename Item>
+  void construct(size_type index, const Item& item) {
+    if constexpr (kHasValues)
+      construct(index, item.first, item.second);
+    else
+      construct(index, item, mapped_type());
+  };
+
+  void construct(size_type index, const Key& key, const mapped_type& value) {
+    key_allocator key_alloc(alloc_);
+    key_traits::construct(key_alloc, keys() + index, key);
+    if constexpr (kHasValues) {
+      try {
+        mapped_allocator mapped_alloc(alloc_);
+        mapped_traits::construct(mapped_alloc, values() + index, value);
+      } catch (...) {
+        key_traits::destroy(key_alloc, keys() + index);
+        throw;
+      }
+    }
+  };
+
+  // destroys the first count keys, and values, in key order
+  void destroy(size_type count) noexcept {
+    if constexpr (!std::is_trivially_destructible<Key>::value ||
+                  !std::is_trivially_destructible<mapped_type>::value) {
+      key_allocator key_alloc(alloc_);
+      mapped_allocator mapped_alloc(alloc_);
+      size_type index = size_ ? leftmost(1) : 0;
+      for (; count; --count, index = successor(index)) {
+        key_traits::destroy(key_alloc, keys() + index);
+        if constexpr (kHasValues)
+          mapped_traits::destroy(mapped_alloc, values() + index);
+      }
+    }
+  };
+
+  void steal(FrozenTree& other) noexcept {
+    blocks_ = other.blocks_;
+    size_ = other.size_;
+    other.blocks_ = nullptr;
+    other.size_ = 0;
+  };
+
+  // Yields the key, or a pair of references to the key and its value when
+  // there are values; operator-> then points into a proxy holding the pair.
+  class FrozenTreeIterator {
+    friend FrozenTree;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type =
+        std::conditional_t<kHasValues, std::pair<const Key, mapped_type>, Key>;
+    using difference_type = std::ptrdiff_t;
+    using reference =
+        std::conditional_t<kHasValues,
+                           std::pair<const Key&, const mapped_type&>,
+                           const Key&>;
+
+    class pointer {
+     public:
+      const std::remove_reference_t<reference>* operator->() const noexcept {
+        return &ref_;
+      };
+
+     private:
+      friend FrozenTreeIterator;
+      explicit pointer(reference ref) : ref_(ref){};
+      reference ref_;
+    };
+
+    FrozenTreeIterator() = default;
+
+    reference operator*() const noexcept {
+      if constexpr (kHasValues)
+        return {tree_->keys()[index_], tree_->values()[index_]};
+      else
+        return tree_->keys()[index_];
+    };
+
+    pointer operator->() const noexcept { return pointer(**this); };
+
+    FrozenTreeIterator& operator++() noexcept {
+      index_ = tree_->successor(index_);
+      return *this;
+    };
+
+    FrozenTreeIterator operator++(int) noexcept {
+      FrozenTreeIterator old = *this;
+      ++*this;
+      return old;
+    };
+
+    FrozenTreeIterator& operator--() noexcept {
+      index_ = tree_->predecessor(index_);
+      return *this;
+    };
+
+    FrozenTreeIterator operator--(int) noexcept {
+      FrozenTreeIterator old = *this;
+      --*this;
+      return old;
+    };
+
+    bool operator==(const FrozenTreeIterator& other) const noexcept {
+      return index_ == other.index_;
+    };
+
+    bool operator!=(const FrozenTreeIterator& other) const noexcept {
+      return index_ != other.index_;
+    };
+
+   private:
+    FrozenTreeIterator(const FrozenTree* tree, size_type index) noexcept
+        : tree_(tree), index_(index){};
+
+    const FrozenTree* tree_ = nullptr;
+    size_type index_ = 0;
+  };
+
+  Block* blocks_ = nullptr;
+  size_type size_ = 0;
+  Allocator alloc_{};
+};
+}  // namespace s21
+
+#endif  // SRC_S21_FROZEN_TREE_H_
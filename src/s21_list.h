@@ -1,8 +1,11 @@
 #ifndef S21_LIST_H
 #define S21_LIST_H
 
+#include <functional>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <memory_resource>
 #include <utility>
 
 namespace s21 {
@@ -14,6 +17,9 @@ struct Node {
 
   Node() : next(nullptr), prev(nullptr), value() {}
   Node(const T val) : next(nullptr), prev(nullptr), value(val) {}
+  template <typename... Args>
+  explicit Node(std::in_place_t, Args &&...args)
+      : next(nullptr), prev(nullptr), value(std::forward<Args>(args)...) {}
 };
 
 template <typename T>
@@ -22,7 +28,7 @@ class ListIterator;
 template <typename T>
 class ListConstIterator;
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class list {
  public:
   // List Member type
@@ -33,10 +39,33 @@ class list {
   using iterator = ListIterator<T>;
   using const_iterator = ListConstIterator<T>;
   using size_type = size_t;
+  using allocator_type = Allocator;
 
  private:
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node<T>>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
   size_type size_;
   Node<T> *base_;
+  node_allocator alloc_;
+
+  template <typename... Args>
+  Node<T> *create_node(Args &&...args) {
+    Node<T> *node = node_traits::allocate(alloc_, 1);
+    try {
+      node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(alloc_, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  void destroy_node(Node<T> *node) noexcept {
+    node_traits::destroy(alloc_, node);
+    node_traits::deallocate(alloc_, node, 1);
+  }
 
   void init() { base_->next = base_->prev = base_; }
 
@@ -53,7 +82,7 @@ class list {
     Node<T> *next = node_to_delete->next, *prev = node_to_delete->prev;
     next->prev = prev;
     prev->next = next;
-    delete node_to_delete;
+    destroy_node(node_to_delete);
     --size_;
     //            base_->value = size_;
   }
@@ -61,21 +90,32 @@ class list {
  public:
   // List Functions
 
-  list() : size_(0), base_(new Node<T>()) { init(); }
+  list() : list(Allocator()) {}
+
+  explicit list(const Allocator &alloc)
+      : size_(0), base_(nullptr), alloc_(alloc) {
+    base_ = create_node();
+    init();
+  }
 
-  list(size_type n) : list() {
+  list(size_type n, const Allocator &alloc = Allocator()) : list(alloc) {
     for (size_type i = 0; i < n; ++i) {
       push_back(value_type());
     }
   }
 
-  list(std::initializer_list<value_type> const &items) : list() {
+  list(std::initializer_list<value_type> const &items,
+       const Allocator &alloc = Allocator())
+      : list(alloc) {
     for (auto const &item : items) {
       push_back(item);
     }
   }
 
-  list(const list &other) : list() {
+  list(const list &other)
+      : list(std::allocator_traits<Allocator>::
+                 select_on_container_copy_construction(
+                     allocator_type(other.alloc_))) {
     Node<T> *current = other.base_->next;
     while (current != other.base_) {
       push_back(current->value);
@@ -83,16 +123,33 @@ class list {
     }
   }
 
-  list(list &&other) : size_(other.size_), base_(other.base_) {
+  list(list &&other)
+      : size_(other.size_), base_(other.base_), alloc_(other.alloc_) {
     other.size_ = 0;
     other.base_ = nullptr;
   }
 
-  // Move assignment operator
-  list &operator=(list &&l) noexcept {
+  // Move assignment operator. The nodes are stolen when the allocators
+  // propagate or compare equal; otherwise (two pmr arenas) they are copied
+  // into our own memory.
+  list &operator=(list &&l) noexcept(
+      node_traits::propagate_on_container_move_assignment::value ||
+      node_traits::is_always_equal::value) {
     if (this != &l) {
+      if constexpr (!node_traits::propagate_on_container_move_assignment::
+                        value) {
+        if (alloc_ != l.alloc_) {
+          *this = l;
+          l.clear();
+          return *this;
+        }
+      }
       clear();
-      delete base_;
+      if (base_) destroy_node(base_);
+      if constexpr (node_traits::propagate_on_container_move_assignment::
+                        value) {
+        alloc_ = l.alloc_;
+      }
       size_ = l.size_;
       base_ = l.base_;
       l.base_ = nullptr;
@@ -115,7 +172,7 @@ class list {
 
   ~list() {
     clear();
-    delete base_;
+    if (base_) destroy_node(base_);
   }
 
   // List Element access - done
@@ -150,8 +207,10 @@ class list {
     }
   }
 
+  allocator_type get_allocator() const { return allocator_type(alloc_); }
+
   iterator insert(iterator pos, const_reference value) {
-    Node<T> *node = new Node<T>(value);
+    Node<T> *node = create_node(value);
     if (!node) throw std::bad_alloc();
     add_node(node, pos.node_);
     return iterator(node);
@@ -168,30 +227,48 @@ class list {
   }
 
   void push_front(const_reference value) {
-    Node<T> *node = new Node<T>(value);
+    Node<T> *node = create_node(value);
     if (!node) throw std::bad_alloc();
     add_node(node, base_->next);
   }
 
   void push_back(const_reference value) {
-    Node<T> *node = new Node<T>(value);
+    Node<T> *node = create_node(value);
     if (!node) throw std::bad_alloc();
     add_node(node, base_);
   }
 
+  // The emplace family builds the value inside the new node.
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    Node<T> *node = create_node(std::in_place, std::forward<Args>(args)...);
+    add_node(node, pos.node_);
+    return iterator(node);
+  }
+
+  template <typename... Args>
+  reference emplace_back(Args &&...args) {
+    return *emplace(cend(), std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  reference emplace_front(Args &&...args) {
+    return *emplace(cbegin(), std::forward<Args>(args)...);
+  }
+
   template <typename... Args>
   iterator insert_many(const_iterator pos, Args &&...args) {
-    return insert(pos, value_type(std::forward<Args>(args)...));
+    return emplace(pos, std::forward<Args>(args)...);
   }
 
   template <typename... Args>
   void insert_many_back(Args &&...args) {
-    push_back(value_type(std::forward<Args>(args)...));
+    emplace_back(std::forward<Args>(args)...);
   }
 
   template <typename... Args>
   void insert_many_front(Args &&...args) {
-    push_front(value_type(std::forward<Args>(args)...));
+    emplace_front(std::forward<Args>(args)...);
   }
 
   void pop_front() {
@@ -211,6 +288,9 @@ class list {
   void swap(list &other) noexcept {
     std::swap(size_, other.size_);
     std::swap(base_, other.base_);
+    if constexpr (node_traits::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
   }
 
   void resize(size_type count) {
@@ -225,32 +305,63 @@ class list {
 
   // List Operations
 
-  void merge(list &other) {
-    if (this != &other) {
-      for (list<T>::iterator it = this->begin();
-           it != this->end() && !other.empty();) {
-        if (*it >= other.front()) {
-          this->insert(it, other.front());
-          other.pop_front();
-        } else {
-          it++;
-        }
-      }
-      while (!other.empty()) {
-        this->push_back(other.front());
-        other.pop_front();
+  // Merges two sorted lists in one pass by relinking the nodes of other.
+  // Equal elements of *this stay in front of those taken from other.
+  template <typename Compare = std::less<value_type>>
+  void merge(list &other, Compare comp = Compare()) {
+    if (this == &other) return;
+    iterator it = begin();
+    while (!other.empty()) {
+      if (it == end()) {
+        splice(it, other);
+      } else if (comp(other.base_->next->value, *it)) {
+        splice(it, other, other.begin());
+      } else {
+        ++it;
       }
     }
   }
 
+  // The splice family moves nodes without copying or allocating. The whole
+  // list and single element forms are O(1); the range form walks the range
+  // to keep both sizes right. Lists whose allocators compare unequal cannot
+  // share nodes, so the values are copied across instead.
   void splice(const_iterator pos, list &other) {
+    if (this == &other || other.empty()) return;
+    if (!shares_memory(other)) {
+      splice(pos, other, other.begin(), other.end());
+      return;
+    }
+    size_ += other.size_;
+    other.size_ = 0;
+    relink(pos.node_, other.base_->next, other.base_);
+  }
+
+  void splice(const_iterator pos, list &other, const_iterator it) {
+    Node<T> *next = it.node_->next;
+    if (pos.node_ == it.node_ || pos.node_ == next) return;
+    splice(pos, other, it, const_iterator(next));
+  }
+
+  void splice(const_iterator pos, list &other, const_iterator first,
+              const_iterator last) {
+    if (first == last) return;
     if (this != &other) {
-      size_type size = other.size();
-      for (size_type i = 0; i < size; ++i) {
-        insert(pos, other.front());
-        other.pop_front();
+      if (!shares_memory(other)) {
+        while (first != last) {
+          insert(pos, *first);
+          first = other.erase(first);
+        }
+        return;
       }
+      size_type count = 0;
+      for (Node<T> *node = first.node_; node != last.node_; node = node->next) {
+        ++count;
+      }
+      size_ += count;
+      other.size_ -= count;
     }
+    relink(pos.node_, first.node_, last.node_);
   }
 
   void reverse() {
@@ -270,19 +381,91 @@ class list {
     }
   }
 
-  void sort() {
-    for (Node<T> *current = base_->next; current != base_;
-         current = current->next) {
-      for (Node<T> *next = current->next; next != base_; next = next->next) {
-        if (current->value > next->value) {
-          std::swap(current->value, next->value);
-        }
+  // Stable bottom-up merge sort. Nodes are relinked, values are never copied
+  // or moved. bins[i] holds a sorted run of 2^i nodes that precede every node
+  // in the lower bins, so runs are always merged older-first.
+  template <typename Compare = std::less<value_type>>
+  void sort(Compare comp = Compare()) {
+    if (size_ < 2) return;
+    Node<T> *bins[64] = {};
+    Node<T> *node = base_->next;
+    base_->prev->next = nullptr;
+    while (node) {
+      Node<T> *carry = node;
+      node = node->next;
+      carry->next = nullptr;
+      size_type i = 0;
+      for (; bins[i]; ++i) {
+        carry = merge_chains(bins[i], carry, comp);
+        bins[i] = nullptr;
       }
+      bins[i] = carry;
     }
+    Node<T> *sorted = nullptr;
+    for (Node<T> *bin : bins) {
+      if (bin) sorted = merge_chains(bin, sorted, comp);
+    }
+    link_chain(sorted);
   }
 
   // List Helpers
 
+ private:
+  bool shares_memory(const list &other) const {
+    if constexpr (node_traits::is_always_equal::value) {
+      return true;
+    } else {
+      return alloc_ == other.alloc_;
+    }
+  }
+
+  // Unhooks [first, last) and hangs it in front of pos.
+  static void relink(Node<T> *pos, Node<T> *first, Node<T> *last) {
+    if (pos == last) return;
+    Node<T> *tail = last->prev;
+    first->prev->next = last;
+    last->prev = first->prev;
+    first->prev = pos->prev;
+    tail->next = pos;
+    pos->prev->next = first;
+    pos->prev = tail;
+  }
+
+  // Merges two null-terminated chains linked through next. Ties go to
+  // first, which keeps the merge stable.
+  template <typename Compare>
+  static Node<T> *merge_chains(Node<T> *first, Node<T> *second,
+                               Compare &comp) {
+    Node<T> *result = nullptr;
+    Node<T> **tail = &result;
+    while (first && second) {
+      if (comp(second->value, first->value)) {
+        *tail = second;
+        second = second->next;
+      } else {
+        *tail = first;
+        first = first->next;
+      }
+      tail = &(*tail)->next;
+    }
+    *tail = first ? first : second;
+    return result;
+  }
+
+  // Puts a null-terminated chain back into the ring behind base_ and
+  // restores the prev links.
+  void link_chain(Node<T> *chain) {
+    Node<T> *prev = base_;
+    for (; chain; prev = chain, chain = chain->next) {
+      prev->next = chain;
+      chain->prev = prev;
+    }
+    prev->next = base_;
+    base_->prev = prev;
+  }
+
+ public:
+
   void print() {
     if (!this->empty()) {
       for (Node<T> *node = base_->next; node != base_; node = node->next) {
@@ -338,7 +521,8 @@ class ListIterator : public std::iterator<std::bidirectional_iterator_tag, T> {
  protected:
   Node<T> *node_;
 
-  friend class list<T>;
+  template <typename, typename>
+  friend class list;
 };
 
 template <typename T>
@@ -351,9 +535,15 @@ class ListConstIterator : public ListIterator<T> {
   ListConstIterator(const ListIterator<T> &it) : ListIterator<T>(it) {}
   // создание копии константного итератора current
   ListConstIterator(const ListConstIterator &it) : ListIterator<T>(it) {}
+  ListConstIterator &operator=(const ListConstIterator &it) = default;
 
   const_reference operator*() const { return this->node_->value; }
 };
+
+namespace pmr {
+template <typename T>
+using list = s21::list<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // S21_LIST_H
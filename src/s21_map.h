@@ -1,33 +1,75 @@
 #ifndef SRC_S21_MAP_H_
 #define SRC_S21_MAP_H_
 
+#include <memory_resource>
+#include <tuple>
+
+#include "s21_arena_tree.h"
 #include "s21_tree.h"
 
 namespace s21 {
-template <typename Key, typename T>
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>,
+          bool OrderStatistics = false, typename Storage = NodeStorage>
 class map {
   using key_type = Key;
   using mapped_type = T;
   using value_type = std::pair<const key_type, mapped_type>;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using tree = RBTree<value_type>;
   using size_type = std::size_t;
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
+
+ public:
+  using key_compare = Compare;
+  using value_compare = PairKeyCompare<Key, T, Compare>;
+
+ private:
+  // NodeStorage keeps the pairs in an RBTree, ArenaStorage in an ArenaTree.
+  using tree = typename Storage::template tree<value_type, value_compare,
+                                               Allocator, OrderStatistics>;
 
  public:
   using iterator = typename tree::iterator;
   using const_iterator = typename tree::const_iterator;
+  using node_pool = typename tree::node_pool;
+  using node_type = typename tree::node_type;
+  using insert_return_type = typename tree::insert_return_type;
+  using allocator_type = Allocator;
 
   map() = default;
 
-  map(std::initializer_list<value_type> const& items) {
-    for (auto it : items) {
-      tree_.insert(it);
-    }
+  explicit map(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_(value_compare(comp), alloc){};
+
+  explicit map(const Allocator& alloc)
+      : tree_(value_compare(Compare()), alloc){};
+
+  explicit map(std::shared_ptr<node_pool> pool,
+               const Compare& comp = Compare())
+      : tree_(value_compare(comp), std::move(pool)){};
+
+  map(std::initializer_list<value_type> const& items,
+      const Compare& comp = Compare(),
+      const Allocator& alloc = Allocator())
+      : tree_(value_compare(comp), alloc) {
+    tree_.assign_sorted(items.begin(), items.end());
+  };
+
+  // Sorted input is built in linear time, see assign_sorted().
+  template <typename ForwardIt, typename = typename std::iterator_traits<
+                                    ForwardIt>::iterator_category>
+  map(ForwardIt first, ForwardIt last, const Compare& comp = Compare(),
+      const Allocator& alloc = Allocator())
+      : tree_(value_compare(comp), alloc) {
+    tree_.assign_sorted(first, last);
   };
 
   map(const map& m) : tree_(m.tree_){};
 
+  map(const map& m, const Allocator& alloc) : tree_(m.tree_, alloc){};
+
   map(map&& m) : tree_(std::move(m.tree_)){};
 
   ~map() = default;
@@ -54,12 +96,14 @@ class map {
     return (*it).second;
   };
 
+  // One descent finds the key or the element it belongs before, which is
+  // then the hint that places a new pair without searching again.
   T& operator[](const Key& key) {
-    value_type value = {key, mapped_type{}};
-    iterator it = map_find(key);
-    if (it == tree_.end()) {
-      auto res = tree_.insert(value);
-      return (*res.first).second;
+    iterator it = tree_.lower_bound(key);
+    if (it == tree_.end() || key_comp()(key, (*it).first)) {
+      it = tree_.emplace_hint(it, std::piecewise_construct,
+                              std::forward_as_tuple(key),
+                              std::forward_as_tuple());
     }
     return (*it).second;
   }
@@ -72,56 +116,165 @@ class map {
 
   const_iterator end() const noexcept { return tree_.end(); };
 
+  key_compare key_comp() const { return tree_.key_comp().key_comp(); };
+
+  value_compare value_comp() const { return tree_.key_comp(); };
+
   bool empty() const noexcept { return tree_.empty(); };
 
   size_type size() const noexcept { return tree_.size(); };
 
   size_type max_size() const noexcept { return tree_.max_size(); };
 
+  std::shared_ptr<node_pool> pool() const noexcept { return tree_.pool(); };
+
+  NodePoolStats pool_stats() const noexcept { return tree_.pool_stats(); };
+
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
   void clear() { tree_.clear(); };
 
   std::pair<iterator, bool> insert(const value_type& value) {
-    iterator it = map_find(value.first);
-    if (it == end()) {
-      auto res = tree_.insert(value);
-      return res;
-    }
-    return {it, false};
+    return tree_.insert(value);
   };
 
   std::pair<iterator, bool> insert(const Key& key, const T& obj) {
-    value_type value = {key, obj};
-    iterator it = map_find(value.first);
-    if (it == end()) {
-      auto res = tree_.insert(value);
-      return res;
-    }
-    return {it, false};
+    return tree_.insert(value_type{key, obj});
   };
 
   std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj) {
-    value_type value = {key, obj};
-    iterator it = map_find(key);
-    if (it == tree_.end())
-      return tree_.insert(value);
-    else {
+    iterator it = tree_.lower_bound(key);
+    if (it != tree_.end() && !key_comp()(key, (*it).first)) {
       (*it).second = obj;
       return {it, false};
     }
+    return {tree_.emplace_hint(it, key, obj), true};
+  };
+
+  iterator insert(const_iterator hint, const_reference value) {
+    return tree_.insert(hint, value);
+  };
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return tree_.emplace(std::forward<Args>(args)...);
   };
 
-  void erase(iterator pos) {
-    auto it = map_find((*pos).first);
-    if (it != end()) tree_.erase(pos);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return tree_.emplace_hint(hint, std::forward<Args>(args)...);
+  };
+
+  // Replaces the contents with [first, last) in O(n) when the range is
+  // sorted; unsorted input still ends up correct, just at insert speed.
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    tree_.assign_sorted(first, last);
+  };
+
+  void erase(iterator pos) { tree_.erase(pos); };
+
+  node_type extract(iterator pos) { return tree_.extract(pos); };
+
+  node_type extract(const_iterator pos) { return tree_.extract(pos); };
+
+  template <typename K = Key>
+  node_type extract(const key_arg<K>& key) {
+    return tree_.template extract<K>(key);
+  };
+
+  // Links the handle's node without allocating when it came from a container
+  // sharing this one's node_pool; a node from another pool is moved into a
+  // fresh node here and its old one is freed.
+  insert_return_type insert(node_type&& nh) {
+    return tree_.insert(std::move(nh));
   };
 
   void swap(map& other) { tree_.swap(other.tree_); };
 
   void merge(map& other) { tree_.merge(other.tree_); };
 
-  bool contains(const Key& key) const noexcept {
-    const_iterator it = map_find(key);
-    return it == end() ? 0 : 1;
+  // Moves the elements not ordered before key into the returned map,
+  // which shares our node pool, and keeps the rest. Nodes are relinked in
+  // O(log n), but without OrderStatistics the smaller side is also walked
+  // to count it, O(min(k, n - k)).
+  template <typename K = Key>
+  map split(const key_arg<K>& key) {
+    return map(tree_.split(key));
+  };
+
+  // Appends other, whose elements must all order after ours. It is relinked
+  // in O(log n) only when both share a node pool; otherwise, or if the
+  // ranges overlap, the elements are merged one by one.
+  void join(map& other) { tree_.join(other.tree_); };
+
+  template <typename K = Key>
+  bool contains(const key_arg<K>& key) const noexcept {
+    return tree_.contains(key);
+  };
+
+  template <typename K = Key>
+  iterator find(const key_arg<K>& key) noexcept {
+    return tree_.find(key);
+  };
+
+  template <typename K = Key>
+  const_iterator find(const key_arg<K>& key) const noexcept {
+    return tree_.find(key);
+  };
+
+  template <typename K = Key>
+  size_type count(const key_arg<K>& key) const noexcept {
+    return tree_.contains(key) ? 1 : 0;
+  };
+
+  // Order statistics, available when OrderStatistics is true.
+  iterator nth(size_type k) noexcept { return tree_.nth(k); };
+
+  const_iterator nth(size_type k) const noexcept { return tree_.nth(k); };
+
+  template <typename K = Key>
+  size_type rank(const key_arg<K>& key) const noexcept {
+    return tree_.template rank<K>(key);
+  };
+
+  template <typename K = Key>
+  size_type count_range(const key_arg<K>& lo,
+                        const key_arg<K>& hi) const noexcept {
+    return tree_.template count_range<K>(lo, hi);
+  };
+
+  template <typename K = Key>
+  std::pair<iterator, iterator> equal_range(const key_arg<K>& key) noexcept {
+    return tree_.equal_range(key);
+  };
+
+  template <typename K = Key>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_arg<K>& key) const noexcept {
+    return tree_.equal_range(key);
+  };
+
+  template <typename K = Key>
+  iterator lower_bound(const key_arg<K>& key) noexcept {
+    return tree_.lower_bound(key);
+  };
+
+  template <typename K = Key>
+  const_iterator lower_bound(const key_arg<K>& key) const noexcept {
+    return tree_.lower_bound(key);
+  };
+
+  template <typename K = Key>
+  iterator upper_bound(const key_arg<K>& key) noexcept {
+    return tree_.upper_bound(key);
+  };
+
+  template <typename K = Key>
+  const_iterator upper_bound(const key_arg<K>& key) const noexcept {
+    return tree_.upper_bound(key);
   };
 
   template <typename... Args>
@@ -130,28 +283,68 @@ class map {
   };
 
  private:
-  iterator map_find(const Key& key) noexcept {
-    iterator it = tree_.begin();
-    if (it == tree_.end() || it == nullptr) return end();
-    while (it != tree_.end()) {
-      if ((*it).first == key) return it;
-      it++;
-    }
-    return end();
-  }
+  iterator map_find(const Key& key) noexcept { return tree_.find(key); }
 
   const_iterator map_find(const Key& key) const noexcept {
-    const_iterator it = tree_.begin();
-    if (it == tree_.end()) return end();
-    while (it != tree_.end()) {
-      if ((*it).first == key) return it;
-      it++;
-    }
-    return end();
+    return tree_.find(key);
   }
 
+  friend struct SetAlgebra;
+
+  explicit map(tree&& t) : tree_(std::move(t)){};
+
   tree tree_{};
 };
+
+// Set algebra on the keys of two maps in one in-order walk, see
+// RBTree::combine(). A key found in both maps keeps its value from a.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          bool OrderStatistics, typename Storage>
+map<Key, T, Compare, Allocator, OrderStatistics, Storage> set_union(
+    const map<Key, T, Compare, Allocator, OrderStatistics, Storage>& a,
+    const map<Key, T, Compare, Allocator, OrderStatistics, Storage>& b) {
+  return SetAlgebra::combine(a, b, SetOperation::kUnion);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          bool OrderStatistics, typename Storage>
+map<Key, T, Compare, Allocator, OrderStatistics, Storage> set_intersection(
+    const map<Key, T, Compare, Allocator, OrderStatistics, Storage>& a,
+    const map<Key, T, Compare, Allocator, OrderStatistics, Storage>& b) {
+  return SetAlgebra::combine(a, b, SetOperation::kIntersection);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          bool OrderStatistics, typename Storage>
+map<Key, T, Compare, Allocator, OrderStatistics, Storage> set_difference(
+    const map<Key, T, Compare, Allocator, OrderStatistics, Storage>& a,
+    const map<Key, T, Compare, Allocator, OrderStatistics, Storage>& b) {
+  return SetAlgebra::combine(a, b, SetOperation::kDifference);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          bool OrderStatistics, typename Storage>
+map<Key, T, Compare, Allocator, OrderStatistics, Storage>
+set_symmetric_difference(
+    const map<Key, T, Compare, Allocator, OrderStatistics, Storage>& a,
+    const map<Key, T, Compare, Allocator, OrderStatistics, Storage>& b) {
+  return SetAlgebra::combine(a, b, SetOperation::kSymmetricDifference);
+}
+
+namespace pmr {
+template <typename Key, typename T, typename Compare = std::less<Key>>
+using map = s21::map<Key, T, Compare,
+                     std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+}  // namespace pmr
+
+// Pairs packed into one array, see ArenaTree. Iterators survive inserts, but
+// any insert, operator[] included, may move the pairs and invalidate
+// references to them: copy a value out before m[a] = m[b] can grow the map.
+namespace arena {
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+using map = s21::map<Key, T, Compare, Allocator, false, ArenaStorage>;
+}  // namespace arena
 }  // namespace s21
 
 #endif  // SRC_S21_MAP_H_
\ No newline at end of file
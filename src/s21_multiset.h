@@ -1,32 +1,64 @@
 #ifndef SRC_S21_MULTISET_H
 #define SRC_S21_MULTISET_H
 
+#include <memory_resource>
+
 #include "s21_tree.h"
 
 namespace s21 {
-template <typename Key>
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>,
+          bool OrderStatistics = false>
 class multiset {
   using key_type = Key;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using tree = RBTree<value_type>;
+  using tree = RBTree<value_type, Compare, Allocator, OrderStatistics>;
   using size_type = std::size_t;
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
 
  public:
   using iterator = typename tree::iterator;
   using const_iterator = typename tree::const_iterator;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using node_pool = typename tree::node_pool;
+  using node_type = typename tree::node_type;
+  using allocator_type = Allocator;
 
   multiset() : tree_(){};
 
-  multiset(std::initializer_list<value_type> const& items) {
-    for (auto it : items) {
-      tree_.insert_duplicate(it);
-    }
+  explicit multiset(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_(comp, alloc){};
+
+  explicit multiset(const Allocator& alloc) : tree_(Compare(), alloc){};
+
+  explicit multiset(std::shared_ptr<node_pool> pool,
+                    const Compare& comp = Compare())
+      : tree_(comp, std::move(pool)){};
+
+  multiset(std::initializer_list<value_type> const& items,
+           const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.assign_sorted_duplicate(items.begin(), items.end());
+  };
+
+  // Sorted input is built in linear time, see assign_sorted().
+  template <typename ForwardIt, typename = typename std::iterator_traits<
+                                    ForwardIt>::iterator_category>
+  multiset(ForwardIt first, ForwardIt last, const Compare& comp = Compare(),
+           const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.assign_sorted_duplicate(first, last);
   };
 
   multiset(const multiset& s) : tree_(s.tree_){};
 
+  multiset(const multiset& s, const Allocator& alloc) : tree_(s.tree_, alloc){};
+
   multiset(multiset&& s) : tree_(std::move(s.tree_)){};
 
   ~multiset() = default;
@@ -43,28 +75,92 @@ class multiset {
 
   iterator insert(const_reference key) { return tree_.insert_duplicate(key); };
 
+  iterator insert(const_iterator hint, const_reference value) {
+    return tree_.insert_duplicate(hint, value);
+  };
+
+  template <typename... Args>
+  iterator emplace(Args&&... args) {
+    return tree_.emplace_duplicate(std::forward<Args>(args)...);
+  };
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return tree_.emplace_hint_duplicate(hint, std::forward<Args>(args)...);
+  };
+
+  // Replaces the contents with [first, last) in O(n) when the range is
+  // sorted; unsorted input still ends up correct, just at insert speed.
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    tree_.assign_sorted_duplicate(first, last);
+  };
+
   void erase(iterator pos) { tree_.erase(pos); };
 
+  node_type extract(iterator pos) { return tree_.extract(pos); };
+
+  node_type extract(const_iterator pos) { return tree_.extract(pos); };
+
+  template <typename K = Key>
+  node_type extract(const key_arg<K>& key) {
+    return tree_.template extract<K>(key);
+  };
+
+  // Links the handle's node without allocating when it came from a container
+  // sharing this one's node_pool; a node from another pool is moved into a
+  // fresh node here and its old one is freed.
+  iterator insert(node_type&& nh) {
+    return tree_.insert_duplicate(std::move(nh));
+  };
+
   bool empty() const noexcept { return tree_.empty(); };
 
   size_type size() const noexcept { return tree_.size(); };
 
   size_type max_size() const noexcept { return tree_.max_size(); };
 
+  std::shared_ptr<node_pool> pool() const noexcept { return tree_.pool(); };
+
+  NodePoolStats pool_stats() const noexcept { return tree_.pool_stats(); };
+
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
   void clear() { tree_.clear(); };
 
   void swap(multiset& other) { tree_.swap(other.tree_); };
 
   void merge(multiset& other) { tree_.merge_duplicates(other.tree_); };
 
-  iterator find(const_reference key) noexcept { return tree_.find(key); };
+  // Moves the elements not ordered before key into the returned multiset,
+  // which shares our node pool, and keeps the rest. Nodes are relinked in
+  // O(log n), but without OrderStatistics the smaller side is also walked
+  // to count it, O(min(k, n - k)).
+  template <typename K = Key>
+  multiset split(const key_arg<K>& key) {
+    return multiset(tree_.template split<K>(key));
+  };
+
+  // Appends other, whose elements must all order after ours. It is relinked
+  // in O(log n) only when both share a node pool; otherwise, or if the
+  // ranges overlap, the elements are merged one by one.
+  void join(multiset& other) { tree_.join_duplicates(other.tree_); };
 
-  const_iterator find(const_reference key) const noexcept {
-    return tree_.find(key);
+  template <typename K = Key>
+  bool contains(const key_arg<K>& key) const noexcept {
+    return tree_.template contains<K>(key);
   };
 
-  bool contains(const_reference key) const noexcept {
-    return tree_.contains(key);
+  template <typename K = Key>
+  iterator find(const key_arg<K>& key) noexcept {
+    return tree_.template find<K>(key);
+  };
+
+  template <typename K = Key>
+  const_iterator find(const key_arg<K>& key) const noexcept {
+    return tree_.template find<K>(key);
   };
 
   iterator begin() noexcept { return tree_.begin(); };
@@ -75,33 +171,60 @@ class multiset {
 
   const_iterator end() const noexcept { return tree_.end(); };
 
-  size_type count(const_reference key) const noexcept {
-    return tree_.count(key);
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  value_compare value_comp() const { return tree_.key_comp(); };
+
+  template <typename K = Key>
+  size_type count(const key_arg<K>& key) const noexcept {
+    return tree_.template count<K>(key);
   };
 
-  std::pair<iterator, iterator> equal_range(const_reference key) noexcept {
-    return tree_.equal_range(key);
+  // Order statistics, available when OrderStatistics is true.
+  iterator nth(size_type k) noexcept { return tree_.nth(k); };
+
+  const_iterator nth(size_type k) const noexcept { return tree_.nth(k); };
+
+  template <typename K = Key>
+  size_type rank(const key_arg<K>& key) const noexcept {
+    return tree_.template rank<K>(key);
   };
 
-  iterator lower_bound(const_reference key) noexcept {
-    return tree_.lower_bound(key);
+  template <typename K = Key>
+  size_type count_range(const key_arg<K>& lo,
+                        const key_arg<K>& hi) const noexcept {
+    return tree_.template count_range<K>(lo, hi);
   };
 
-  iterator upper_bound(const_reference key) noexcept {
-    return tree_.upper_bound(key);
+  template <typename K = Key>
+  std::pair<iterator, iterator> equal_range(const key_arg<K>& key) noexcept {
+    return tree_.template equal_range<K>(key);
   };
 
+  template <typename K = Key>
   std::pair<const_iterator, const_iterator> equal_range(
-      const_reference key) const noexcept {
-    return tree_.equal_range(key);
+      const key_arg<K>& key) const noexcept {
+    return tree_.template equal_range<K>(key);
+  };
+
+  template <typename K = Key>
+  iterator lower_bound(const key_arg<K>& key) noexcept {
+    return tree_.template lower_bound<K>(key);
   };
 
-  const_iterator lower_bound(const_reference key) const noexcept {
-    return tree_.lower_bound(key);
+  template <typename K = Key>
+  const_iterator lower_bound(const key_arg<K>& key) const noexcept {
+    return tree_.template lower_bound<K>(key);
   };
 
-  const_iterator upper_bound(const_reference key) const noexcept {
-    return tree_.upper_bound(key);
+  template <typename K = Key>
+  iterator upper_bound(const key_arg<K>& key) noexcept {
+    return tree_.template upper_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  const_iterator upper_bound(const key_arg<K>& key) const noexcept {
+    return tree_.template upper_bound<K>(key);
   };
 
   template <typename... Args>
@@ -110,8 +233,51 @@ class multiset {
   };
 
  private:
+  friend struct SetAlgebra;
+
+  explicit multiset(tree&& t) : tree_(std::move(t)){};
+
   tree tree_;
 };
+
+// Set algebra on two multisets in one in-order walk, see RBTree::combine().
+template <typename Key, typename Compare, typename Allocator,
+          bool OrderStatistics>
+multiset<Key, Compare, Allocator, OrderStatistics> set_union(
+    const multiset<Key, Compare, Allocator, OrderStatistics>& a,
+    const multiset<Key, Compare, Allocator, OrderStatistics>& b) {
+  return SetAlgebra::combine(a, b, SetOperation::kUnion);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          bool OrderStatistics>
+multiset<Key, Compare, Allocator, OrderStatistics> set_intersection(
+    const multiset<Key, Compare, Allocator, OrderStatistics>& a,
+    const multiset<Key, Compare, Allocator, OrderStatistics>& b) {
+  return SetAlgebra::combine(a, b, SetOperation::kIntersection);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          bool OrderStatistics>
+multiset<Key, Compare, Allocator, OrderStatistics> set_difference(
+    const multiset<Key, Compare, Allocator, OrderStatistics>& a,
+    const multiset<Key, Compare, Allocator, OrderStatistics>& b) {
+  return SetAlgebra::combine(a, b, SetOperation::kDifference);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          bool OrderStatistics>
+multiset<Key, Compare, Allocator, OrderStatistics> set_symmetric_difference(
+    const multiset<Key, Compare, Allocator, OrderStatistics>& a,
+    const multiset<Key, Compare, Allocator, OrderStatistics>& b) {
+  return SetAlgebra::combine(a, b, SetOperation::kSymmetricDifference);
+}
+
+namespace pmr {
+template <typename Key, typename Compare = std::less<Key>>
+using multiset =
+    s21::multiset<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // SRC_S21_MULTISET_H
\ No newline at end of file
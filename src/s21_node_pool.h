@@ -0,0 +1,142 @@
+#ifndef SRC_S21_NODE_POOL_H_
+#define SRC_S21_NODE_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace s21 {
+struct NodePoolStats {
+  std::size_t chunks;    // chunks currently owned by the pool
+  std::size_t capacity;  // node slots in those chunks
+  std::size_t in_use;    // slots handed out and not yet returned
+  std::size_t free;      // returned slots waiting on the free list
+  std::size_t bytes;     // memory held by the chunks
+};
+
+// Slab allocator for fixed-size nodes. Slots are carved from contiguous
+// chunks that double in size up to max_chunk_, returned slots go to an
+// intrusive free list, and memory goes back to the allocator only when the
+// whole pool is released.
+template <typename Node, typename Allocator = std::allocator<Node>>
+class NodePool {
+  using size_type = std::size_t;
+
+  union Slot {
+    Slot* next_;
+    struct {
+      Slot* next_;
+      size_type size_;
+    } chunk_;
+    alignas(Node) unsigned char storage_[sizeof(Node)];
+  };
+
+  using slot_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+  using slot_traits = std::allocator_traits<slot_allocator>;
+
+ public:
+  explicit NodePool(const Allocator& alloc = Allocator(),
+                    size_type first_chunk = 32, size_type max_chunk = 4096)
+      : alloc_(alloc),
+        next_chunk_(first_chunk ? first_chunk : 1),
+        first_chunk_(next_chunk_),
+        max_chunk_(max_chunk < next_chunk_ ? next_chunk_ : max_chunk){};
+
+  NodePool(const NodePool&) = delete;
+  NodePool& operator=(const NodePool&) = delete;
+
+  ~NodePool() { release(); };
+
+  // Raw storage for one Node; the caller constructs it in place.
+  Node* allocate() {
+    Slot* slot = free_list_;
+    if (slot != nullptr) {
+      free_list_ = slot->next_;
+      --stats_.free;
+    } else {
+      if (cursor_ == cursor_end_) add_chunk();
+      slot = cursor_++;
+    }
+    ++stats_.in_use;
+    return reinterpret_cast<Node*>(slot->storage_);
+  };
+
+  // n adjacent slots, for bulk builds that want their nodes side by side.
+  // They are cut from a chunk and never from the free list; whatever is left
+  // of the current chunk joins the free list when a new one is needed.
+  Node* allocate_batch(size_type n) {
+    static_assert(sizeof(Slot) == sizeof(Node),
+                  "batch slots must be laid out like an array of Node");
+    if (static_cast<size_type>(cursor_end_ - cursor_) < n) {
+      while (cursor_ != cursor_end_) {
+        Slot* slot = cursor_++;
+        slot->next_ = free_list_;
+        free_list_ = slot;
+        ++stats_.free;
+      }
+      add_chunk(n);
+    }
+    Slot* first = cursor_;
+    cursor_ += n;
+    stats_.in_use += n;
+    return reinterpret_cast<Node*>(first->storage_);
+  };
+
+  // Takes back the storage of a Node that is already destroyed.
+  void deallocate(Node* node) noexcept {
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next_ = free_list_;
+    free_list_ = slot;
+    --stats_.in_use;
+    ++stats_.free;
+  };
+
+  // Frees every chunk at once. All nodes must be destroyed beforehand.
+  void release() noexcept {
+    while (chunks_ != nullptr) {
+      Slot* next = chunks_->chunk_.next_;
+      slot_traits::deallocate(alloc_, chunks_, chunks_->chunk_.size_);
+      chunks_ = next;
+    }
+    free_list_ = cursor_ = cursor_end_ = nullptr;
+    next_chunk_ = first_chunk_;
+    stats_ = NodePoolStats{};
+  };
+
+  NodePoolStats stats() const noexcept { return stats_; };
+
+  Allocator get_allocator() const noexcept { return Allocator(alloc_); };
+
+ private:
+  // The first slot of every chunk records its size and links it to the
+  // previously allocated one. A chunk holds at least min_slots slots.
+  void add_chunk(size_type min_slots = 0) {
+    size_type slots = min_slots > next_chunk_ ? min_slots : next_chunk_;
+    Slot* chunk = slot_traits::allocate(alloc_, slots + 1);
+    chunk->chunk_.next_ = chunks_;
+    chunk->chunk_.size_ = slots + 1;
+    chunks_ = chunk;
+    cursor_ = chunk + 1;
+    cursor_end_ = cursor_ + slots;
+    stats_.chunks++;
+    stats_.capacity += slots;
+    stats_.bytes += (slots + 1) * sizeof(Slot);
+    if (next_chunk_ < max_chunk_) {
+      next_chunk_ = next_chunk_ * 2 < max_chunk_ ? next_chunk_ * 2 : max_chunk_;
+    }
+  };
+
+  slot_allocator alloc_;
+  Slot* chunks_ = nullptr;
+  Slot* free_list_ = nullptr;
+  Slot* cursor_ = nullptr;
+  Slot* cursor_end_ = nullptr;
+  size_type next_chunk_;
+  size_type first_chunk_;
+  size_type max_chunk_;
+  NodePoolStats stats_{};
+};
+}  // namespace s21
+
+#endif  // SRC_S21_NODE_POOL_H_
@@ -4,14 +4,15 @@
 #include "s21_list.h"
 
 namespace s21 {
-template <typename T>
-class queue : private s21::list<T> {
+template <typename T, typename Allocator = std::allocator<T>>
+class queue : private s21::list<T, Allocator> {
  public:
-  using list = s21::list<T>;
+  using list = s21::list<T, Allocator>;
   using value_type = T;
   using reference = T &;
   using const_reference = const T &;
   using size_type = size_t;
+  using allocator_type = Allocator;
 
   // Queue Operations
 
@@ -25,6 +26,7 @@ class queue : private s21::list<T> {
   // Queue Capacity
 
   using list::empty;
+  using list::get_allocator;
   using list::size;
 
   // Queue Modifiers
@@ -42,6 +44,11 @@ class queue : private s21::list<T> {
 
   using list::print;
 };
+
+namespace pmr {
+template <typename T>
+using queue = s21::queue<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // SRC_S21_QUEUE_H__
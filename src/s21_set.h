@@ -1,32 +1,68 @@
 #ifndef SRC_S21_SET_H_
 #define SRC_S21_SET_H_
 
+#include <memory_resource>
+
+#include "s21_arena_tree.h"
 #include "s21_tree.h"
 
 namespace s21 {
-template <typename Key>
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>,
+          bool OrderStatistics = false, typename Storage = NodeStorage>
 class set {
   using key_type = Key;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using tree = RBTree<value_type>;
+  // NodeStorage keeps the keys in an RBTree, ArenaStorage in an ArenaTree.
+  using tree = typename Storage::template tree<value_type, Compare, Allocator,
+                                               OrderStatistics>;
   using size_type = std::size_t;
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
 
  public:
   using iterator = typename tree::iterator;
   using const_iterator = typename tree::const_iterator;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using node_pool = typename tree::node_pool;
+  using node_type = typename tree::node_type;
+  using insert_return_type = typename tree::insert_return_type;
+  using allocator_type = Allocator;
 
   set() : tree_(){};
 
-  set(std::initializer_list<value_type> const& items) {
-    for (auto it : items) {
-      tree_.insert(it);
-    }
+  explicit set(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_(comp, alloc){};
+
+  explicit set(const Allocator& alloc) : tree_(Compare(), alloc){};
+
+  explicit set(std::shared_ptr<node_pool> pool,
+               const Compare& comp = Compare())
+      : tree_(comp, std::move(pool)){};
+
+  set(std::initializer_list<value_type> const& items,
+      const Compare& comp = Compare(),
+      const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.assign_sorted(items.begin(), items.end());
+  };
+
+  // Sorted input is built in linear time, see assign_sorted().
+  template <typename ForwardIt, typename = typename std::iterator_traits<
+                                    ForwardIt>::iterator_category>
+  set(ForwardIt first, ForwardIt last, const Compare& comp = Compare(),
+      const Allocator& alloc = Allocator())
+      : tree_(comp, alloc) {
+    tree_.assign_sorted(first, last);
   };
 
   set(const set& s) : tree_(s.tree_){};
 
+  set(const set& s, const Allocator& alloc) : tree_(s.tree_, alloc){};
+
   set(set&& s) : tree_(std::move(s.tree_)){};
 
   ~set() = default;
@@ -49,21 +85,141 @@ class set {
 
   size_type max_size() const noexcept { return tree_.max_size(); };
 
+  std::shared_ptr<node_pool> pool() const noexcept { return tree_.pool(); };
+
+  NodePoolStats pool_stats() const noexcept { return tree_.pool_stats(); };
+
+  allocator_type get_allocator() const noexcept {
+    return tree_.get_allocator();
+  };
+
+  iterator insert(const_iterator hint, const_reference value) {
+    return tree_.insert(hint, value);
+  };
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return tree_.emplace(std::forward<Args>(args)...);
+  };
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    return tree_.emplace_hint(hint, std::forward<Args>(args)...);
+  };
+
+  // Replaces the contents with [first, last) in O(n) when the range is
+  // sorted; unsorted input still ends up correct, just at insert speed.
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    tree_.assign_sorted(first, last);
+  };
+
   void erase(iterator pos) { tree_.erase(pos); };
 
+  node_type extract(iterator pos) { return tree_.extract(pos); };
+
+  node_type extract(const_iterator pos) { return tree_.extract(pos); };
+
+  template <typename K = Key>
+  node_type extract(const key_arg<K>& key) {
+    return tree_.template extract<K>(key);
+  };
+
+  // Links the handle's node without allocating when it came from a container
+  // sharing this one's node_pool; a node from another pool is moved into a
+  // fresh node here and its old one is freed.
+  insert_return_type insert(node_type&& nh) {
+    return tree_.insert(std::move(nh));
+  };
+
   bool empty() const noexcept { return tree_.empty(); };
 
   void clear() { tree_.clear(); };
 
   void swap(set& other) { tree_.swap(other.tree_); };
 
-  void merge(set& other) noexcept { tree_.merge(other.tree_); };
+  void merge(set& other) { tree_.merge(other.tree_); };
+
+  // Moves the elements not ordered before key into the returned set,
+  // which shares our node pool, and keeps the rest. Nodes are relinked in
+  // O(log n), but without OrderStatistics the smaller side is also walked
+  // to count it, O(min(k, n - k)).
+  template <typename K = Key>
+  set split(const key_arg<K>& key) {
+    return set(tree_.template split<K>(key));
+  };
 
-  bool contains(const_reference key) const { return tree_.contains(key); };
+  // Appends other, whose elements must all order after ours. It is relinked
+  // in O(log n) only when both share a node pool; otherwise, or if the
+  // ranges overlap, the elements are merged one by one.
+  void join(set& other) { tree_.join(other.tree_); };
 
-  iterator find(const_reference key) { return tree_.find(key); };
+  template <typename K = Key>
+  bool contains(const key_arg<K>& key) const {
+    return tree_.template contains<K>(key);
+  };
 
-  const_iterator find(const_reference key) const { return tree_.find(key); };
+  template <typename K = Key>
+  iterator find(const key_arg<K>& key) {
+    return tree_.template find<K>(key);
+  };
+
+  template <typename K = Key>
+  const_iterator find(const key_arg<K>& key) const {
+    return tree_.template find<K>(key);
+  };
+
+  template <typename K = Key>
+  size_type count(const key_arg<K>& key) const noexcept {
+    return tree_.template count<K>(key);
+  };
+
+  // Order statistics, available when OrderStatistics is true.
+  iterator nth(size_type k) noexcept { return tree_.nth(k); };
+
+  const_iterator nth(size_type k) const noexcept { return tree_.nth(k); };
+
+  template <typename K = Key>
+  size_type rank(const key_arg<K>& key) const noexcept {
+    return tree_.template rank<K>(key);
+  };
+
+  template <typename K = Key>
+  size_type count_range(const key_arg<K>& lo,
+                        const key_arg<K>& hi) const noexcept {
+    return tree_.template count_range<K>(lo, hi);
+  };
+
+  template <typename K = Key>
+  std::pair<iterator, iterator> equal_range(const key_arg<K>& key) noexcept {
+    return tree_.template equal_range<K>(key);
+  };
+
+  template <typename K = Key>
+  std::pair<const_iterator, const_iterator> equal_range(
+      const key_arg<K>& key) const noexcept {
+    return tree_.template equal_range<K>(key);
+  };
+
+  template <typename K = Key>
+  iterator lower_bound(const key_arg<K>& key) noexcept {
+    return tree_.template lower_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  const_iterator lower_bound(const key_arg<K>& key) const noexcept {
+    return tree_.template lower_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  iterator upper_bound(const key_arg<K>& key) noexcept {
+    return tree_.template upper_bound<K>(key);
+  };
+
+  template <typename K = Key>
+  const_iterator upper_bound(const key_arg<K>& key) const noexcept {
+    return tree_.template upper_bound<K>(key);
+  };
 
   iterator begin() noexcept { return tree_.begin(); };
 
@@ -73,14 +229,68 @@ class set {
 
   const_iterator end() const noexcept { return tree_.end(); };
 
+  key_compare key_comp() const { return tree_.key_comp(); };
+
+  value_compare value_comp() const { return tree_.key_comp(); };
+
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
     return tree_.insert_many(std::forward<Args>(args)...);
   };
 
  private:
+  friend struct SetAlgebra;
+
+  explicit set(tree&& t) : tree_(std::move(t)){};
+
   tree tree_;
 };
+
+// Set algebra on two sets in one in-order walk, see RBTree::combine().
+template <typename Key, typename Compare, typename Allocator,
+          bool OrderStatistics, typename Storage>
+set<Key, Compare, Allocator, OrderStatistics, Storage> set_union(
+    const set<Key, Compare, Allocator, OrderStatistics, Storage>& a,
+    const set<Key, Compare, Allocator, OrderStatistics, Storage>& b) {
+  return SetAlgebra::combine(a, b, SetOperation::kUnion);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          bool OrderStatistics, typename Storage>
+set<Key, Compare, Allocator, OrderStatistics, Storage> set_intersection(
+    const set<Key, Compare, Allocator, OrderStatistics, Storage>& a,
+    const set<Key, Compare, Allocator, OrderStatistics, Storage>& b) {
+  return SetAlgebra::combine(a, b, SetOperation::kIntersection);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          bool OrderStatistics, typename Storage>
+set<Key, Compare, Allocator, OrderStatistics, Storage> set_difference(
+    const set<Key, Compare, Allocator, OrderStatistics, Storage>& a,
+    const set<Key, Compare, Allocator, OrderStatistics, Storage>& b) {
+  return SetAlgebra::combine(a, b, SetOperation::kDifference);
+}
+
+template <typename Key, typename Compare, typename Allocator,
+          bool OrderStatistics, typename Storage>
+set<Key, Compare, Allocator, OrderStatistics, Storage> set_symmetric_difference(
+    const set<Key, Compare, Allocator, OrderStatistics, Storage>& a,
+    const set<Key, Compare, Allocator, OrderStatistics, Storage>& b) {
+  return SetAlgebra::combine(a, b, SetOperation::kSymmetricDifference);
+}
+
+namespace pmr {
+template <typename Key, typename Compare = std::less<Key>>
+using set = s21::set<Key, Compare, std::pmr::polymorphic_allocator<Key>>;
+}  // namespace pmr
+
+// Keys packed into one array, see ArenaTree. Iterators survive inserts, but
+// any insert may move the keys and invalidate references to them.
+namespace arena {
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+using set = s21::set<Key, Compare, Allocator, false, ArenaStorage>;
+}  // namespace arena
 }  // namespace s21
 
 #endif  // SRC_S21_SET_H_
\ No newline at end of file
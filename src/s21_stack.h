@@ -4,15 +4,16 @@
 #include "s21_list.h"
 
 namespace s21 {
-template <typename T>
-class stack : private s21::list<T> {
+template <typename T, typename Allocator = std::allocator<T>>
+class stack : private s21::list<T, Allocator> {
  public:
-  using list = s21::list<T>;
+  using list = s21::list<T, Allocator>;
   using value_type = T;
   using reference = T &;
   using const_reference = const T &;
   using iterator = s21::ListIterator<T>;
   using size_type = size_t;
+  using allocator_type = Allocator;
 
   // Stack Operations
 
@@ -25,6 +26,7 @@ class stack : private s21::list<T> {
   // Stack Capacity
 
   using list::empty;
+  using list::get_allocator;
   using list::size;
 
   // Stack Modifiers
@@ -42,6 +44,11 @@ class stack : private s21::list<T> {
 
   using list::print;
 };
+
+namespace pmr {
+template <typename T>
+using stack = s21::stack<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
 }  // namespace s21
 
 #endif  // SRC_S21_STACK_H__
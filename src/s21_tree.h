@@ -1,67 +1,150 @@
 #ifndef SRC_S21_TREE_H_
 #define SRC_S21_TREE_H_
 
+#include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "s21_compare.h"
+#include "s21_node_pool.h"
+
 namespace s21 {
-template <typename Key>
-class RBTree {
+// Number of nodes in the subtree under a node, kept only by trees that
+// answer order-statistic queries. The empty specialization adds nothing to
+// the nodes of all other trees.
+template <bool Enabled>
+struct SubtreeSize {
+  std::size_t count_ = 1;
+};
+
+template <>
+struct SubtreeSize<false> {};
+
+// What RBTree::combine() computes. Repeated keys are treated as in the
+// <algorithm> functions of the same names: equal elements pair off one to
+// one, so a union keeps the larger count and an intersection the smaller.
+enum class SetOperation {
+  kUnion,
+  kIntersection,
+  kDifference,
+  kSymmetricDifference
+};
+
+// OrderStatistics makes every node track its subtree size, which gives
+// nth(), rank() and count_range() in O(log n) at the price of one word per
+// node and a walk to the root on every insert and erase.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>,
+          bool OrderStatistics = false>
+class RBTree : private CompareStorage<Compare> {
   class RBTreeNode;
   class RBTreeIterator;
   class RBTreeConstIterator;
+  class RBTreeNodeHandle;
   using reference = Key&;
   using const_reference = const Key&;
   using Node_P = RBTreeNode*;
   using size_type = std::size_t;
-  using comparator = std::less<Key>;
+  using compare_storage = CompareStorage<Compare>;
+  using alloc_traits = std::allocator_traits<Allocator>;
+  using node_allocator =
+      typename alloc_traits::template rebind_alloc<RBTreeNode>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+  template <typename K>
+  using key_arg = LookupKeyType<Compare, K, Key>;
 
   enum NodeColor { BL, RD };
+  static constexpr std::uintptr_t kColorMask = 1;
 
  public:
   using value_type = Key;
+  using key_compare = Compare;
   using iterator = RBTreeIterator;
   using const_iterator = RBTreeConstIterator;
+  using allocator_type = Allocator;
+  using node_pool = NodePool<RBTreeNode, Allocator>;
+  using node_type = RBTreeNodeHandle;
+
+  struct insert_return_type {
+    iterator position;
+    bool inserted;
+    node_type node;
+  };
+
+  RBTree() : RBTree(Compare()){};
+
+  explicit RBTree(const Compare& comp, const Allocator& alloc = Allocator())
+      : RBTree(comp, std::allocate_shared<node_pool>(alloc, alloc)){};
 
-  RBTree() : root_(new RBTreeNode), size_(0){};
+  // Trees built over the same pool hand nodes to each other in merge without
+  // reallocating them. The pool also supplies the tree's allocator.
+  RBTree(const Compare& comp, std::shared_ptr<node_pool> pool)
+      : compare_storage(comp), size_(0), pool_(std::move(pool)) {
+    root_ = create_sentinel();
+  };
 
-  RBTree(const RBTree& other) : RBTree() { *this = other; };
+  RBTree(const RBTree& other)
+      : RBTree(other.key_comp(),
+               alloc_traits::select_on_container_copy_construction(
+                   other.get_allocator())) {
+    *this = other;
+  };
 
-  RBTree(RBTree&& other) : RBTree() { *this = std::move(other); };
+  RBTree(const RBTree& other, const Allocator& alloc)
+      : RBTree(other.key_comp(), alloc) {
+    *this = other;
+  };
+
+  RBTree(RBTree&& other) : RBTree(other.key_comp(), other.get_allocator()) {
+    *this = std::move(other);
+  };
 
   ~RBTree() {
     clear();
-    delete_node(root_);
+    destroy_sentinel();
   };
 
   RBTree& operator=(const RBTree& other) {
     if (this != &other) {
+      compare_storage::operator=(other);
       if (other.size_ == 0) {
         clear();
       } else {
-        if (root_->parent_) clear();
-        Node_P root = copy(other.root_->parent_, nullptr);
-        root_->parent_ = root;
-        root_->parent_->parent_ = root;
-        root_->left_ = other.root_->left_;
-        root_->right_ = other.root_->right_;
+        if (root_->parent()) clear();
+        Node_P root = copy(other.root_->parent(), root_);
+        root_->set_parent(root);
+        root_->left_ = search_Left(root);
+        root_->right_ = search_right(root);
         size_ = other.size_;
       }
     }
     return *this;
   };
 
+  // Like the standard containers, a non-propagating allocator that differs
+  // from ours (two pmr arenas) keeps our memory: the elements are copied.
   RBTree& operator=(RBTree&& other) {
-    if (this != &other) {
+    if (this != &other &&
+        !alloc_traits::propagate_on_container_move_assignment::value &&
+        get_allocator() != other.get_allocator()) {
+      *this = other;
+      other.clear();
+    } else if (this != &other) {
       clear();
+      compare_storage::swap(other);
       std::swap(this->root_, other.root_);
       std::swap(this->size_, other.size_);
-    } else {
-      other.clear();
-      delete_node(other.root_);
+      std::swap(this->pool_, other.pool_);
     }
     return *this;
   };
@@ -72,11 +155,14 @@ class RBTree {
   };
 
   const_iterator begin() const noexcept {
+    if (size_ == 0) return const_iterator(root_);
     return const_iterator(root_->left_);
   };
 
   iterator end() noexcept { return iterator(root_); };
 
+  key_compare key_comp() const { return compare_storage::get(); };
+
   const_iterator end() const noexcept { return const_iterator(root_); };
 
   bool empty() const noexcept { return size_ ? 0 : 1; };
@@ -91,156 +177,219 @@ class RBTree {
     return size;
   };
 
+  // A pool owned by this tree alone gives its chunks back in one go; values
+  // that need no destructor are not even visited then.
   void clear() {
-    delete_all(root_->parent_);
-    root_->parent_ = nullptr;
+    bool own_pool = pool_.use_count() == 1;
+    if (!own_pool || !std::is_trivially_destructible<Key>::value)
+      delete_all(root_->parent());
+    if (own_pool) pool_->release();
+    root_->set_parent(nullptr);
     root_->left_ = nullptr;
     root_->right_ = nullptr;
     size_ = 0;
   };
 
   std::pair<iterator, bool> insert(const value_type& value) {
-    Node_P new_node = new RBTreeNode(value);
+    Node_P new_node = create_node(value);
     std::pair<iterator, bool> res = insert_node(new_node, true);
-    if (!res.second) delete_node(new_node);
+    if (!res.second) destroy_node(new_node);
     return res;
   };
 
   iterator insert_duplicate(const value_type& value) {
-    Node_P new_node = new RBTreeNode(value);
+    Node_P new_node = create_node(value);
     return insert_node(new_node, false).first;
   };
 
+  // The hinted forms are O(1) plus rebalancing when the value belongs right
+  // before or right after hint, and search from the root otherwise.
+  iterator insert(const_iterator hint, const value_type& value) {
+    return emplace_hint(hint, value);
+  };
+
+  iterator insert_duplicate(const_iterator hint, const value_type& value) {
+    return emplace_hint_duplicate(hint, value);
+  };
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args) {
+    Node_P new_node = create_node(std::in_place, std::forward<Args>(args)...);
+    std::pair<iterator, bool> res = insert_node(hint.node_, new_node, true);
+    if (!res.second) destroy_node(new_node);
+    return res.first;
+  };
+
+  template <typename... Args>
+  iterator emplace_hint_duplicate(const_iterator hint, Args&&... args) {
+    Node_P new_node = create_node(std::in_place, std::forward<Args>(args)...);
+    return insert_node(hint.node_, new_node, false).first;
+  };
+
+  // Replaces the contents with [first, last). While the range is sorted its
+  // nodes are cut from one contiguous block and linked into a perfectly
+  // balanced tree in O(n); the first element out of order and everything
+  // after it go through the regular insert.
+  template <typename ForwardIt>
+  void assign_sorted(ForwardIt first, ForwardIt last) {
+    assign_range(first, last, true);
+  };
+
+  template <typename ForwardIt>
+  void assign_sorted_duplicate(ForwardIt first, ForwardIt last) {
+    assign_range(first, last, false);
+  };
+
   void erase(iterator pos) { delete_node(pos); };
 
+  // Unlinks the node at pos and hands it out; nothing is copied or freed.
+  node_type extract(const_iterator pos) {
+    if (pos == end()) return node_type();
+    return node_type(merge_Node(pos.node_), pool_);
+  };
+
+  node_type extract(iterator pos) { return extract(const_iterator(pos)); };
+
+  template <typename K = Key>
+  node_type extract(const key_arg<K>& key) {
+    return extract(const_iterator(find_node(key)));
+  };
+
+  // A node from a tree sharing our pool is linked as is. Any other node has
+  // to move its value into our pool first.
+  insert_return_type insert(node_type&& nh) {
+    std::pair<iterator, bool> res = insert_handle(nh, true);
+    if (res.second) return {res.first, true, node_type()};
+    return {res.first, false, std::move(nh)};
+  };
+
+  iterator insert_duplicate(node_type&& nh) {
+    return insert_handle(nh, false).first;
+  };
+
   void swap(RBTree& other) {
     using std::swap;
+    compare_storage::swap(other);
     swap(root_, other.root_);
     swap(size_, other.size_);
+    swap(pool_, other.pool_);
   };
 
-  iterator find(const_reference key) noexcept {
-    iterator res = iterator(find_node(key));
-    if (res == end() || comparator{}(*res, key)) return end();
-    return res;
+  std::shared_ptr<node_pool> pool() const noexcept { return pool_; };
+
+  allocator_type get_allocator() const noexcept {
+    return pool_->get_allocator();
   };
 
-  const_iterator find(const_reference key) const noexcept {
-    const_iterator res = lower_bound(key);
-    if (res == end() || comparator{}(*res, key)) return end();
-    return res;
+  NodePoolStats pool_stats() const noexcept { return pool_->stats(); };
+
+  template <typename K = Key>
+  iterator find(const key_arg<K>& key) noexcept {
+    return iterator(find_node(key));
+  };
+
+  template <typename K = Key>
+  const_iterator find(const key_arg<K>& key) const noexcept {
+    return const_iterator(find_node(key));
   };
 
-  bool contains(const_reference key) const noexcept {
+  template <typename K = Key>
+  bool contains(const key_arg<K>& key) const noexcept {
     Node_P node = find_node(key);
     return (node != root_);
   };
 
-  iterator upper_bound(const_reference value) noexcept {
-    iterator result = end();
-    Node_P begin = root_->parent_;
-    while (begin != nullptr) {
-      if (comparator{}(value, begin->data_)) {
-        result = iterator(begin);
-        begin = begin->left_;
-      } else
-        begin = begin->right_;
-    }
-    return result;
+  template <typename K = Key>
+  iterator upper_bound(const key_arg<K>& value) noexcept {
+    return iterator(upper_bound_node(value));
   };
 
-  const_iterator upper_bound(const_reference value) const noexcept {
-    const_iterator result = end();
-    Node_P begin = root_->parent_;
-    while (begin != nullptr) {
-      if (comparator{}(value, begin->data_)) {
-        result = const_iterator(begin);
-        begin = begin->left_;
-      } else
-        begin = begin->right_;
-    }
-    return result;
+  template <typename K = Key>
+  const_iterator upper_bound(const key_arg<K>& value) const noexcept {
+    return const_iterator(upper_bound_node(value));
   };
 
-  iterator lower_bound(const_reference value) noexcept {
-    iterator result = end();
-    Node_P begin = root_->parent_;
-    while (begin != nullptr) {
-      if (comparator{}(begin->data_, value)) {
-        begin = begin->right_;
-      } else {
-        result = iterator(begin);
-        begin = begin->left_;
-      }
-    }
-    return result;
+  template <typename K = Key>
+  iterator lower_bound(const key_arg<K>& value) noexcept {
+    return iterator(lower_bound_node(value));
   };
 
-  const_iterator lower_bound(const_reference value) const noexcept {
-    const_iterator result = end();
-    Node_P begin = root_->parent_;
-    while (begin != nullptr) {
-      if (comparator{}(begin->data_, value)) {
-        begin = begin->right_;
-      } else {
-        result = const_iterator(begin);
-        begin = begin->left_;
-      }
-    }
-    return result;
+  template <typename K = Key>
+  const_iterator lower_bound(const key_arg<K>& value) const noexcept {
+    return const_iterator(lower_bound_node(value));
   };
 
-  size_type count(const_reference key) const noexcept {
-    const_iterator it = begin();
-    size_type c = 0;
-    for (size_type i = 0; i < size(); i++) {
-      if (*it == key) c++;
-      it++;
+  // Elements equivalent to key. With subtree sizes this is the difference of
+  // two ranks; otherwise the equal run after lower_bound is walked.
+  template <typename K = Key>
+  size_type count(const key_arg<K>& key) const noexcept {
+    Node_P node = lower_bound_node(key);
+    if (node == root_ || compare(key, node->data_)) return 0;
+    if constexpr (OrderStatistics) {
+      return bound_rank(key, true) - bound_rank(key, false);
+    } else {
+      const_iterator it(node), last = end();
+      size_type c = 0;
+      for (; it != last && !compare(key, *it); ++it) c++;
+      return c;
     }
-    return c;
   };
 
-  std::pair<iterator, iterator> equal_range(const_reference key) noexcept {
-    iterator start = lower_bound(key), end = upper_bound(key);
+  // k-th smallest element, counting from 0; end() when k >= size().
+  iterator nth(size_type k) noexcept { return iterator(nth_node(k)); };
+
+  const_iterator nth(size_type k) const noexcept {
+    return const_iterator(nth_node(k));
+  };
+
+  // Number of elements ordered before key.
+  template <typename K = Key>
+  size_type rank(const key_arg<K>& key) const noexcept {
+    static_assert(OrderStatistics, "rank() needs OrderStatistics = true");
+    return bound_rank(key, false);
+  };
+
+  // Number of elements in [lo, hi).
+  template <typename K = Key>
+  size_type count_range(const key_arg<K>& lo,
+                        const key_arg<K>& hi) const noexcept {
+    size_type below_hi = rank<K>(hi), below_lo = rank<K>(lo);
+    return below_hi > below_lo ? below_hi - below_lo : 0;
+  };
+
+  template <typename K = Key>
+  std::pair<iterator, iterator> equal_range(const key_arg<K>& key) noexcept {
+    iterator start = lower_bound<K>(key), end = upper_bound<K>(key);
     return {start, end};
   };
 
+  template <typename K = Key>
   std::pair<const_iterator, const_iterator> equal_range(
-      const_reference key) const noexcept {
-    const_iterator start = lower_bound(key), end = upper_bound(key);
+      const key_arg<K>& key) const noexcept {
+    const_iterator start = lower_bound<K>(key), end = upper_bound<K>(key);
     return {start, end};
   };
 
-  void merge_duplicates(RBTree& other) noexcept {
+  void merge_duplicates(RBTree& other) {
     if (this != &other) {
       iterator it = other.begin();
-      while (other.size_ > 0) {
+      while (it != other.end()) {
         Node_P node = it.node_;
         it++;
-        if (node->parent_->left_ == node) node->parent_->left_ = nullptr;
-        if (node->parent_->right_ == node) node->parent_->right_ = nullptr;
-        if (node->right_) node->right_->parent_ = node->parent_;
-        if (node->left_) node->left_->parent_ = node->parent_;
-        node->left_ = nullptr;
-        node->right_ = nullptr;
-        node->parent_ = nullptr;
-        node->color_ = RD;
+        node = adopt_node(other, other.merge_Node(node));
         insert_node(node, false);
-        other.size_--;
       }
     }
-    other.root_->parent_ = nullptr;
-    other.size_ = 0;
   };
 
-  void merge(RBTree& other) noexcept {
+  void merge(RBTree& other) {
     if (this != &other) {
       iterator it = other.begin();
       while (it != other.end()) {
         if (find(it.node_->data_) == end()) {
           Node_P node = it.node_;
           it++;
-          node = other.merge_Node(node);
+          node = adopt_node(other, other.merge_Node(node));
           insert_node(node, true);
         } else
           it++;
@@ -248,18 +397,111 @@ class RBTree {
     }
   };
 
+  // Moves the elements not ordered before key into the returned tree, which
+  // shares our pool; the rest stay here. Nodes are relinked, never copied:
+  // one descent cuts the tree and joins the pieces it passes in O(log n).
+  // Without subtree sizes the smaller half is also walked to count it.
+  template <typename K = Key>
+  RBTree split(const key_arg<K>& key) {
+    RBTree upper(key_comp(), pool_);
+    if (size_ == 0) return upper;
+    size_type total = size_;
+    size_type lower_size = count_before(lower_bound_node(key));
+    std::pair<Piece, Piece> parts = split_piece(take_piece(), key);
+    adopt_piece(parts.first, lower_size);
+    upper.adopt_piece(parts.second, total - lower_size);
+    return upper;
+  };
+
+  // Builds a op b from one in-order walk over both trees, O(n + m), and
+  // links the result with the bulk-build path. Intersection and difference
+  // do not have to visit every element of a much larger operand: it is
+  // entered with lower_bound() where the walk needs it, O(m log n).
+  static RBTree combine(const RBTree& a, const RBTree& b, SetOperation op) {
+    RBTree result(a.key_comp(),
+                  alloc_traits::select_on_container_copy_construction(
+                      a.get_allocator()));
+    bool keep_a = op != SetOperation::kIntersection;
+    bool keep_b = op == SetOperation::kUnion ||
+                  op == SetOperation::kSymmetricDifference;
+    bool keep_both =
+        op == SetOperation::kUnion || op == SetOperation::kIntersection;
+    size_type bound = keep_b   ? a.size_ + b.size_
+                      : keep_a ? a.size_
+                               : std::min(a.size_, b.size_);
+    if (bound == 0) return result;
+    bool skip_a = !keep_a && lookups_pay_off(b.size_, a.size_);
+    bool skip_b = !keep_b && lookups_pay_off(a.size_, b.size_);
+    Node_P batch = result.pool_->allocate_batch(bound);
+    size_type built = 0;
+    auto emit = [batch, &built](const_iterator it) {
+      new (batch + built) RBTreeNode(std::in_place, *it);
+      ++built;
+    };
+    try {
+      const_iterator i = a.begin(), j = b.begin();
+      const_iterator a_end = a.end(), b_end = b.end();
+      while (i != a_end && j != b_end) {
+        if (a.compare(*i, *j)) {
+          if (keep_a) emit(i);
+          if (skip_a)
+            i = const_iterator(a.lower_bound_node(*j));
+          else
+            ++i;
+        } else if (a.compare(*j, *i)) {
+          if (keep_b) emit(j);
+          if (skip_b)
+            j = const_iterator(b.lower_bound_node(*i));
+          else
+            ++j;
+        } else {
+          if (keep_both) emit(i);
+          ++i;
+          ++j;
+        }
+      }
+      for (; keep_a && i != a_end; ++i) emit(i);
+      for (; keep_b && j != b_end; ++j) emit(j);
+    } catch (...) {
+      for (size_type k = 0; k < built; ++k) batch[k].~RBTreeNode();
+      for (size_type k = 0; k < bound; ++k) result.pool_->deallocate(batch + k);
+      throw;
+    }
+    for (size_type k = built; k < bound; ++k)
+      result.pool_->deallocate(batch + k);
+    result.link_sorted(batch, built);
+    return result;
+  };
+
+  // Appends other, all of whose elements must order after ours, in O(log n)
+  // and leaves it empty. Overlapping ranges and trees on different pools
+  // cannot be relinked and go through merge() instead.
+  void join(RBTree& other) { join_tree(other, true); };
+
+  void join_duplicates(RBTree& other) { join_tree(other, false); };
+
+  // Builds the value inside a fresh node; for unique trees the node is
+  // dropped again when the key is already present.
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    Node_P new_node = create_node(std::in_place, std::forward<Args>(args)...);
+    std::pair<iterator, bool> res = insert_node(new_node, true);
+    if (!res.second) destroy_node(new_node);
+    return res;
+  };
+
+  template <typename... Args>
+  iterator emplace_duplicate(Args&&... args) {
+    Node_P new_node = create_node(std::in_place, std::forward<Args>(args)...);
+    return insert_node(new_node, false).first;
+  };
+
+  // One element per argument, each constructed in its node.
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args&&... args) {
     std::vector<std::pair<iterator, bool>> vect;
     vect.reserve(sizeof...(args));
-    for (auto element : {std::forward<Args>(args)...}) {
-      Node_P new_node = new RBTreeNode(std::move(element));
-      std::pair<iterator, bool> result = insert_node(new_node, true);
-      if (result.second == false) {
-        delete new_node;
-      }
-      vect.push_back(result);
-    }
+    (vect.push_back(emplace(std::forward<Args>(args))), ...);
     return vect;
   }
 
@@ -267,38 +509,137 @@ class RBTree {
   std::vector<std::pair<iterator, bool>> insert_many_duplicate(Args&&... args) {
     std::vector<std::pair<iterator, bool>> vect;
     vect.reserve(sizeof...(args));
-    for (auto element : {std::forward<Args>(args)...}) {
-      Node_P new_node = new RBTreeNode(std::move(element));
-      vect.push_back(insert_node(new_node, false));
-    }
+    (vect.push_back({emplace_duplicate(std::forward<Args>(args)), true}), ...);
     return vect;
   }
 
  private:
+  template <typename A, typename B>
+  bool compare(const A& a, const B& b) const {
+    return compare_storage::get()(a, b);
+  };
+
+  // Elements ordered before key, or also those equivalent to it when
+  // inclusive is set.
+  template <typename K>
+  size_type bound_rank(const K& key, bool inclusive) const noexcept {
+    size_type rank = 0;
+    Node_P node = root_->parent();
+    while (node != nullptr) {
+      if (inclusive ? !compare(key, node->data_) : compare(node->data_, key)) {
+        rank += subtree_size(node->left_) + 1;
+        node = node->right_;
+      } else {
+        node = node->left_;
+      }
+    }
+    return rank;
+  };
+
+  static size_type subtree_size(Node_P node) noexcept {
+    if constexpr (OrderStatistics) {
+      return node ? node->count_ : 0;
+    } else {
+      return 0;
+    }
+  };
+
+  void update_size(Node_P node) noexcept {
+    if constexpr (OrderStatistics) {
+      node->count_ = 1 + subtree_size(node->left_) + subtree_size(node->right_);
+    }
+  };
+
+  // Counts a node linked (grow) or unlinked below node in every subtree
+  // size on the way to the root.
+  void resize_path(Node_P node, bool grow) noexcept {
+    if constexpr (OrderStatistics) {
+      for (; node != root_; node = node->parent()) {
+        grow ? ++node->count_ : --node->count_;
+      }
+    }
+  };
+
+  Node_P nth_node(size_type k) const noexcept {
+    static_assert(OrderStatistics, "nth() needs OrderStatistics = true");
+    Node_P node = root_->parent();
+    while (node != nullptr) {
+      size_type left = subtree_size(node->left_);
+      if (k < left) {
+        node = node->left_;
+      } else if (k == left) {
+        return node;
+      } else {
+        k -= left + 1;
+        node = node->right_;
+      }
+    }
+    return root_;
+  };
+
+  // One comparison per level: equal keys go right, and for unique trees the
+  // only possible duplicate is the in-order predecessor of the insert point.
   std::pair<iterator, bool> insert_node(Node_P new_node, bool unique) {
-    Node_P node = root_->parent_;
+    Node_P node = root_->parent();
     Node_P parent = nullptr;
+    bool to_left = true;
     while (node != nullptr) {
       parent = node;
-      if (comparator{}(new_node->data_, node->data_))
-        node = node->left_;
-      else if (comparator{}(node->data_, new_node->data_))
-        node = node->right_;
-      else if (unique == false)
-        node = node->right_;
-      else
-        return {iterator(node), false};
+      to_left = compare(new_node->data_, node->data_);
+      node = to_left ? node->left_ : node->right_;
     }
+    if (unique && parent != nullptr) {
+      Node_P prev = parent;
+      if (to_left)
+        prev = parent == root_->left_ ? nullptr : parent->predecessor();
+      if (prev != nullptr && !compare(prev->data_, new_node->data_))
+        return {iterator(prev), false};
+    }
+    return link_node(new_node, parent, to_left);
+  };
+
+  // Tries the slots right before and right after hint. For unique trees the
+  // neighbours must be strictly ordered around the value, otherwise equal
+  // keys may sit next to it.
+  std::pair<iterator, bool> insert_node(Node_P hint, Node_P new_node,
+                                        bool unique) {
+    if (size_ != 0) {
+      const Key& value = new_node->data_;
+      auto fits = [this, unique](const Key& a, const Key& b) {
+        return unique ? compare(a, b) : !compare(b, a);
+      };
+      Node_P prev = hint == root_->left_ ? nullptr : hint->predecessor();
+      if ((hint == root_ || fits(value, hint->data_)) &&
+          (prev == nullptr || fits(prev->data_, value))) {
+        if (prev != nullptr && prev->right_ == nullptr)
+          return link_node(new_node, prev, false);
+        return link_node(new_node, hint, true);
+      }
+      if (hint != root_ && fits(hint->data_, value)) {
+        Node_P next = hint->successor();
+        if (next == root_ || fits(value, next->data_)) {
+          if (hint->right_ == nullptr) return link_node(new_node, hint, false);
+          return link_node(new_node, next, true);
+        }
+      }
+    }
+    return insert_node(new_node, unique);
+  };
+
+  // Hangs new_node under parent (nullptr for an empty tree) and rebalances.
+  std::pair<iterator, bool> link_node(Node_P new_node, Node_P parent,
+                                      bool to_left) {
     size_++;
     if (parent == nullptr) {
-      new_node->parent_ = root_;
-      root_->parent_ = new_node;
-      new_node->color_ = BL;
+      new_node->set_parent(root_);
+      root_->set_parent(new_node);
+      new_node->set_color(BL);
     } else {
-      new_node->parent_ = parent;
-      comparator{}(new_node->data_, parent->data_) ? parent->left_ = new_node
-                                                   : parent->right_ = new_node;
+      new_node->set_parent(parent);
+      to_left ? parent->left_ = new_node : parent->right_ = new_node;
     }
+    update_size(new_node);
+    resize_path(parent ? parent : root_, true);
     if (!root_->right_ || root_->right_->right_) {
       root_->right_ = new_node;
     }
@@ -307,90 +648,366 @@ class RBTree {
     return {iterator(new_node), true};
   };
 
-  void delete_node(Node_P node) {
-    if (node != nullptr) {
-      node->left_ = nullptr;
-      node->right_ = nullptr;
-      node->parent_ = nullptr;
-      delete node;
-      node = nullptr;
+  template <typename ForwardIt>
+  void assign_range(ForwardIt first, ForwardIt last, bool unique) {
+    clear();
+    size_type n = std::distance(first, last);
+    if (n == 0) return;
+    Node_P batch = pool_->allocate_batch(n);
+    size_type built = 0;
+    try {
+      for (; first != last; ++first) {
+        Node_P node = new (batch + built) RBTreeNode(std::in_place, *first);
+        if (built != 0) {
+          bool before = compare(node->data_, node[-1].data_);
+          if (before || (unique && !compare(node[-1].data_, node->data_))) {
+            node->~RBTreeNode();
+            if (before) break;
+            continue;
+          }
+        }
+        ++built;
+      }
+    } catch (...) {
+      for (size_type i = 0; i < built; ++i) batch[i].~RBTreeNode();
+      for (size_type i = 0; i < n; ++i) pool_->deallocate(batch + i);
+      throw;
+    }
+    for (size_type i = built; i < n; ++i) pool_->deallocate(batch + i);
+    link_sorted(batch, built);
+    for (; first != last; ++first) {
+      Node_P node = create_node(std::in_place, *first);
+      if (!insert_node(node, unique).second) destroy_node(node);
+    }
+  };
+
+  // Whether m descents into a tree of n elements cost less than walking it.
+  static bool lookups_pay_off(size_type m, size_type n) noexcept {
+    size_type depth = 1;
+    while (depth < std::numeric_limits<size_type>::digits &&
+           (size_type{1} << depth) < n)
+      ++depth;
+    return m < n / depth;
+  };
+
+  // A detached subtree with a black root, and the number of black nodes on
+  // each of its paths.
+  struct Piece {
+    Node_P root;
+    int black_height;
+  };
+
+  static int black_height(Node_P node) noexcept {
+    int height = 0;
+    for (; node != nullptr; node = node->left_) height += node->color() == BL;
+    return height;
+  };
+
+  // Cuts node loose from its parent; a red root turns black and so adds a
+  // level to the black height it had as a subtree.
+  static Piece detach(Node_P node, int height) noexcept {
+    if (node == nullptr) return {nullptr, 0};
+    node->set_parent(nullptr);
+    if (node->color() == RD) {
+      node->set_color(BL);
+      ++height;
     }
+    return {node, height};
+  };
+
+  static void set_children(Node_P node, Node_P left, Node_P right) noexcept {
+    node->left_ = left;
+    node->right_ = right;
+    if (left) left->set_parent(node);
+    if (right) right->set_parent(node);
+  };
+
+  // Unlinks the whole tree, leaving it empty, and returns it as a piece.
+  Piece take_piece() noexcept {
+    Node_P root = root_->parent();
+    root_->set_parent(nullptr);
+    root_->left_ = nullptr;
+    root_->right_ = nullptr;
+    size_ = 0;
+    return detach(root, black_height(root));
+  };
+
+  // Installs a piece holding count elements into this empty tree.
+  void adopt_piece(Piece piece, size_type count) noexcept {
+    root_->set_parent(piece.root);
+    if (piece.root != nullptr) {
+      piece.root->set_parent(root_);
+      root_->left_ = search_Left(piece.root);
+      root_->right_ = search_right(piece.root);
+    }
+    size_ = count;
+  };
+
+  // Number of elements before node, from subtree sizes when we have them;
+  // otherwise from whichever end of the sequence reaches node first.
+  size_type count_before(Node_P node) const noexcept {
+    if (node == root_) return size_;
+    if constexpr (OrderStatistics) {
+      size_type before = subtree_size(node->left_);
+      for (; node->parent() != root_; node = node->parent()) {
+        if (node == node->parent()->right_)
+          before += subtree_size(node->parent()->left_) + 1;
+      }
+      return before;
+    } else {
+      const_iterator front = begin(), back(node), bound(node), last = end();
+      for (size_type steps = 0;; ++steps, ++front, ++back) {
+        if (front == bound) return steps;
+        if (back == last) return size_ - steps;
+      }
+    }
+  };
+
+  template <typename K>
+  std::pair<Piece, Piece> split_piece(Piece piece, const K& key) {
+    Node_P node = piece.root;
+    if (node == nullptr) return {piece, piece};
+    Piece left = detach(node->left_, piece.black_height - 1);
+    Piece right = detach(node->right_, piece.black_height - 1);
+    if (compare(node->data_, key)) {
+      std::pair<Piece, Piece> parts = split_piece(right, key);
+      return {join_pieces(left, node, parts.first), parts.second};
+    }
+    std::pair<Piece, Piece> parts = split_piece(left, key);
+    return {parts.first, join_pieces(parts.second, node, right)};
+  };
+
+  // Joins left, mid and right, in that order, into one piece. mid goes
+  // down the spine of the taller piece to the first black node as high as
+  // the other piece and is rebalanced from there, which costs the
+  // difference of the black heights. The sentinel holds the taller piece
+  // meanwhile, so it must not be in use.
+  Piece join_pieces(Piece left, Node_P mid, Piece right) noexcept {
+    if (left.black_height == right.black_height) {
+      set_children(mid, left.root, right.root);
+      mid->set_parent(nullptr);
+      mid->set_color(BL);
+      update_size(mid);
+      return {mid, left.black_height + 1};
+    }
+    bool into_left = left.black_height > right.black_height;
+    Piece tall = into_left ? left : right;
+    int target = into_left ? right.black_height : left.black_height;
+    root_->set_parent(tall.root);
+    tall.root->set_parent(root_);
+    Node_P parent = root_, node = tall.root;
+    for (int height = tall.black_height;
+         node != nullptr && (node->color() == RD || height > target);
+         node = into_left ? node->right_ : node->left_) {
+      height -= node->color() == BL;
+      parent = node;
+    }
+    mid->set_parent(parent);
+    mid->set_color(RD);
+    if (into_left) {
+      parent->right_ = mid;
+      set_children(mid, node, right.root);
+    } else {
+      parent->left_ = mid;
+      set_children(mid, left.root, node);
+    }
+    for (node = mid; node != root_; node = node->parent()) update_size(node);
+    bool grew = balance_insert(mid);
+    Piece joined{root_->parent(), tall.black_height + grew};
+    joined.root->set_parent(nullptr);
+    root_->set_parent(nullptr);
+    return joined;
+  };
+
+  void join_tree(RBTree& other, bool unique) {
+    if (this == &other || other.size_ == 0) return;
+    bool ordered =
+        size_ == 0 ||
+        (unique ? compare(root_->right_->data_, other.root_->left_->data_)
+                : !compare(other.root_->left_->data_, root_->right_->data_));
+    if (pool_ != other.pool_ || !ordered) {
+      unique ? merge(other) : merge_duplicates(other);
+      return;
+    }
+    size_type total = size_ + other.size_;
+    Node_P mid = other.merge_Node(other.root_->left_);
+    Piece right = other.take_piece();
+    Piece left = take_piece();
+    adopt_piece(join_pieces(left, mid, right), total);
+  };
+
+  // Links count sorted nodes into an empty tree, middle element on top. Only
+  // the deepest level, which may be incomplete, is red, so every path holds
+  // the same number of black nodes.
+  void link_sorted(Node_P nodes, size_type count) {
+    if (count == 0) return;
+    size_type red_depth = 0;
+    while ((size_type{2} << red_depth) <= count) ++red_depth;
+    Node_P root = build_balanced(nodes, count, root_, 0, red_depth);
+    root->set_color(BL);
+    root_->set_parent(root);
+    root_->left_ = nodes;
+    root_->right_ = nodes + count - 1;
+    size_ = count;
+  };
+
+  Node_P build_balanced(Node_P nodes, size_type count, Node_P parent,
+                        size_type depth, size_type red_depth) noexcept {
+    if (count == 0) return nullptr;
+    size_type mid = count / 2;
+    Node_P node = nodes + mid;
+    node->set_parent(parent);
+    node->set_color(depth == red_depth ? RD : BL);
+    node->left_ = build_balanced(nodes, mid, node, depth + 1, red_depth);
+    node->right_ = build_balanced(nodes + mid + 1, count - mid - 1, node,
+                                  depth + 1, red_depth);
+    update_size(node);
+    return node;
+  };
+
+  std::pair<iterator, bool> insert_handle(node_type& nh, bool unique) {
+    if (nh.empty()) return {end(), false};
+    if (nh.pool_ != pool_) {
+      if (unique) {
+        Node_P dup = find_node(nh.node_->data_);
+        if (dup != root_) return {iterator(dup), false};
+      }
+      Node_P node = create_node(std::move(nh.node_->data_));
+      nh.reset();
+      return insert_node(node, unique);
+    }
+    std::pair<iterator, bool> res = insert_node(nh.node_, unique);
+    if (res.second) nh.release();
+    return res;
+  };
+
+  // The sentinel carries a value-initialized key, so it comes from the
+  // allocator rather than from the pool that clear() releases.
+  Node_P create_sentinel() {
+    node_allocator alloc(pool_->get_allocator());
+    Node_P node = node_traits::allocate(alloc, 1);
+    try {
+      new (node) RBTreeNode();
+    } catch (...) {
+      node_traits::deallocate(alloc, node, 1);
+      throw;
+    }
+    return node;
+  };
+
+  void destroy_sentinel() noexcept {
+    node_allocator alloc(pool_->get_allocator());
+    root_->~RBTreeNode();
+    node_traits::deallocate(alloc, root_, 1);
+  };
+
+  template <typename... Args>
+  Node_P create_node(Args&&... args) {
+    Node_P node = pool_->allocate();
+    try {
+      new (node) RBTreeNode(std::forward<Args>(args)...);
+    } catch (...) {
+      pool_->deallocate(node);
+      throw;
+    }
+    return node;
+  };
+
+  void destroy_node(Node_P node) noexcept {
+    node->~RBTreeNode();
+    pool_->deallocate(node);
+  };
+
+  // A node detached from other must live in our pool before we link it.
+  Node_P adopt_node(RBTree& other, Node_P node) {
+    if (pool_ == other.pool_) return node;
+    Node_P own = create_node(std::move(node->data_));
+    other.destroy_node(node);
+    return own;
   };
 
   void left_rotate(Node_P node) noexcept {
     Node_P help_node = node->right_;
     node->right_ = help_node->left_;
     if (help_node->left_ != nullptr) {
-      help_node->left_->parent_ = node;
+      help_node->left_->set_parent(node);
     }
-    help_node->parent_ = node->parent_;
-    if (node->parent_ == root_) {
-      root_->parent_ = help_node;
-    } else if (node == node->parent_->left_) {
-      node->parent_->left_ = help_node;
+    help_node->set_parent(node->parent());
+    if (node->parent() == root_) {
+      root_->set_parent(help_node);
+    } else if (node == node->parent()->left_) {
+      node->parent()->left_ = help_node;
     } else {
-      node->parent_->right_ = help_node;
+      node->parent()->right_ = help_node;
     }
     help_node->left_ = node;
-    node->parent_ = help_node;
+    node->set_parent(help_node);
+    if constexpr (OrderStatistics) help_node->count_ = node->count_;
+    update_size(node);
   };
 
   void right_rotate(Node_P node) noexcept {
     Node_P help_node = node->left_;
     node->left_ = help_node->right_;
     if (help_node->right_ != nullptr) {
-      help_node->right_->parent_ = node;
+      help_node->right_->set_parent(node);
     }
-    help_node->parent_ = node->parent_;
-    if (root_->parent_ == node) {
-      root_->parent_ = help_node;
-    } else if (node == node->parent_->right_) {
-      node->parent_->right_ = help_node;
-    } else if (node == node->parent_->left_) {
-      node->parent_->left_ = help_node;
+    help_node->set_parent(node->parent());
+    if (root_->parent() == node) {
+      root_->set_parent(help_node);
+    } else if (node == node->parent()->right_) {
+      node->parent()->right_ = help_node;
+    } else if (node == node->parent()->left_) {
+      node->parent()->left_ = help_node;
     }
     help_node->right_ = node;
-    node->parent_ = help_node;
+    node->set_parent(help_node);
+    if constexpr (OrderStatistics) help_node->count_ = node->count_;
+    update_size(node);
   };
 
-  void balance_insert(Node_P node) noexcept {
+  // Returns true when the fix-up reached the root, which adds one black
+  // node to every path.
+  bool balance_insert(Node_P node) noexcept {
     Node_P u;
-    while (node->parent_->color_ == RD && node != root_->parent_) {
-      if (node->parent_ == node->parent_->parent_->right_) {
-        u = node->parent_->parent_->left_;
-        if (u != nullptr && u->color_ == RD) {
-          u->color_ = BL;
-          node->parent_->color_ = BL;
-          node->parent_->parent_->color_ = RD;
-          node = node->parent_->parent_;
+    while (node->parent()->color() == RD && node != root_->parent()) {
+      if (node->parent() == node->parent()->parent()->right_) {
+        u = node->parent()->parent()->left_;
+        if (u != nullptr && u->color() == RD) {
+          u->set_color(BL);
+          node->parent()->set_color(BL);
+          node->parent()->parent()->set_color(RD);
+          node = node->parent()->parent();
         } else {
-          if (node == node->parent_->left_) {
-            node = node->parent_;
+          if (node == node->parent()->left_) {
+            node = node->parent();
             right_rotate(node);
           }
-          node->parent_->color_ = BL;
-          node->parent_->parent_->color_ = RD;
-          left_rotate(node->parent_->parent_);
+          node->parent()->set_color(BL);
+          node->parent()->parent()->set_color(RD);
+          left_rotate(node->parent()->parent());
         }
       } else {
-        u = node->parent_->parent_->right_;
-        if (u != nullptr && u->color_ == RD) {
-          u->color_ = BL;
-          node->parent_->color_ = BL;
-          node->parent_->parent_->color_ = RD;
-          node = node->parent_->parent_;
+        u = node->parent()->parent()->right_;
+        if (u != nullptr && u->color() == RD) {
+          u->set_color(BL);
+          node->parent()->set_color(BL);
+          node->parent()->parent()->set_color(RD);
+          node = node->parent()->parent();
         } else {
-          if (node == node->parent_->right_) {
-            node = node->parent_;
+          if (node == node->parent()->right_) {
+            node = node->parent();
             left_rotate(node);
           }
-          node->parent_->color_ = BL;
-          node->parent_->parent_->color_ = RD;
-          right_rotate(node->parent_->parent_);
+          node->parent()->set_color(BL);
+          node->parent()->parent()->set_color(RD);
+          right_rotate(node->parent()->parent());
         }
       }
     }
-    root_->parent_->color_ = BL;
+    bool grew = root_->parent()->color() == RD;
+    root_->parent()->set_color(BL);
+    return grew;
   };
 
   Node_P search_right(Node_P node) noexcept {
@@ -408,38 +1025,64 @@ class RBTree {
   };
 
   void swap_Nodes(Node_P one, Node_P two) noexcept {
-    two == two->parent_->left_ ? two->parent_->left_ = one
-                               : two->parent_->right_ = one;
-    if (one == root_->parent_)
-      root_->parent_ = two;
+    two == two->parent()->left_ ? two->parent()->left_ = one
+                                : two->parent()->right_ = one;
+    if (one == root_->parent())
+      root_->set_parent(two);
     else
-      one == one->parent_->left_ ? one->parent_->left_ = two
-                                 : one->parent_->right_ = two;
+      one == one->parent()->left_ ? one->parent()->left_ = two
+                                  : one->parent()->right_ = two;
     std::swap(one->left_, two->left_);
     std::swap(one->right_, two->right_);
-    std::swap(one->parent_, two->parent_);
-    std::swap(one->color_, two->color_);
-    if (one->left_) one->left_->parent_ = one;
-    if (one->right_) one->right_->parent_ = one;
-    if (two->left_) two->left_->parent_ = two;
-    if (two->right_) two->right_->parent_ = two;
-  };
-
-  Node_P find_node(const_reference key) const noexcept {
-    Node_P ptr = root_->parent_;
-    while (ptr) {
-      if (ptr->data_ == key) return ptr;
-      if (comparator{}(ptr->data_, key))
-        ptr = ptr->right_;
-      else
-        ptr = ptr->left_;
+    std::swap(one->parent_color_, two->parent_color_);
+    if constexpr (OrderStatistics) std::swap(one->count_, two->count_);
+    if (one->left_) one->left_->set_parent(one);
+    if (one->right_) one->right_->set_parent(one);
+    if (two->left_) two->left_->set_parent(two);
+    if (two->right_) two->right_->set_parent(two);
+  };
+
+  static void swap_colors(Node_P one, Node_P two) noexcept {
+    NodeColor color = one->color();
+    one->set_color(two->color());
+    two->set_color(color);
+  };
+
+  template <typename K>
+  Node_P find_node(const K& key) const noexcept {
+    Node_P node = lower_bound_node(key);
+    if (node == root_ || compare(key, node->data_)) return root_;
+    return node;
+  };
+
+  template <typename K>
+  Node_P lower_bound_node(const K& key) const noexcept {
+    Node_P result = root_;
+    Node_P node = root_->parent();
+    while (node != nullptr) {
+      if (compare(node->data_, key)) {
+        node = node->right_;
+      } else {
+        result = node;
+        node = node->left_;
+      }
     }
-    return root_;
+    return result;
   };
 
-  Node_P find_node(iterator pos) const noexcept {
-    Node_P res = find_node(*pos);
-    return res;
+  template <typename K>
+  Node_P upper_bound_node(const K& key) const noexcept {
+    Node_P result = root_;
+    Node_P node = root_->parent();
+    while (node != nullptr) {
+      if (compare(key, node->data_)) {
+        result = node;
+        node = node->left_;
+      } else {
+        node = node->right_;
+      }
+    }
+    return result;
   };
 
   void delete_node(iterator pos) {
@@ -455,20 +1098,21 @@ class RBTree {
     if (!node->right_ && node->left_ != nullptr) {
       swap_Nodes(node, node->left_);
     }
-    if (node->color_ == BL && (!node->left_ && !node->right_)) {
+    if (node->color() == BL && (!node->left_ && !node->right_)) {
       balance_delete(node);
     }
-    if (root_->parent_ == node) {
-      root_->parent_ = nullptr;
+    if (root_->parent() == node) {
+      root_->set_parent(nullptr);
       root_->right_ = nullptr;
       root_->left_ = nullptr;
     } else {
-      node->parent_->left_ == node ? node->parent_->left_ = nullptr
-                                   : node->parent_->right_ = nullptr;
-      if (root_->left_ == node) root_->left_ = search_Left(root_->parent_);
-      if (root_->right_ == node) root_->right_ = search_right(root_->parent_);
+      node->parent()->left_ == node ? node->parent()->left_ = nullptr
+                                    : node->parent()->right_ = nullptr;
+      resize_path(node->parent(), false);
+      if (root_->left_ == node) root_->left_ = search_Left(root_->parent());
+      if (root_->right_ == node) root_->right_ = search_right(root_->parent());
     }
-    delete_node(node);
+    destroy_node(node);
     size_--;
   };
 
@@ -480,20 +1124,25 @@ class RBTree {
       }
       if (node->right_ && !node->left_) swap_Nodes(node, node->right_);
       if (node->left_ && !node->right_) swap_Nodes(node, node->left_);
-      if (node->color_ == BL && (!node->right_ && !node->left_))
+      if (node->color() == BL && (!node->right_ && !node->left_))
         balance_delete(node);
-      if (root_->left_ == node) root_->left_ = node->successor();
-      if (root_->right_ == node) root_->right_ = node->predecessor();
-      if (root_->parent_ == node)
-        root_->parent_ = nullptr;
-      else
-        node->parent_->left_ == node ? node->parent_->left_ = nullptr
-                                     : node->parent_->right_ = nullptr;
+      if (root_->parent() == node) {
+        root_->set_parent(nullptr);
+        root_->left_ = nullptr;
+        root_->right_ = nullptr;
+      } else {
+        node->parent()->left_ == node ? node->parent()->left_ = nullptr
+                                      : node->parent()->right_ = nullptr;
+        resize_path(node->parent(), false);
+        if (root_->left_ == node) root_->left_ = search_Left(root_->parent());
+        if (root_->right_ == node)
+          root_->right_ = search_right(root_->parent());
+      }
       size_--;
       node->left_ = nullptr;
       node->right_ = nullptr;
-      node->parent_ = nullptr;
-      node->color_ = RD;
+      node->set_parent(nullptr);
+      node->set_color(RD);
       return node;
     }
     return nullptr;
@@ -501,132 +1150,155 @@ class RBTree {
 
   void balance_delete(Node_P node) {
     Node_P s = nullptr;
-    while (node != root_->parent_ && node->color_ == BL) {
-      if (node == node->parent_->left_) {
-        s = node->parent_->right_;
-        if (s->color_ == RD) {
-          std::swap(s->color_, node->parent_->color_);
-          left_rotate(node->parent_);
-          s = node->parent_->right_;
+    while (node != root_->parent() && node->color() == BL) {
+      if (node == node->parent()->left_) {
+        s = node->parent()->right_;
+        if (s->color() == RD) {
+          swap_colors(s, node->parent());
+          left_rotate(node->parent());
+          s = node->parent()->right_;
         }
-        if (s->color_ == BL && (!s->left_ || s->left_->color_ == BL) &&
-            (!s->right_ || s->right_->color_ == BL)) {
-          s->color_ = RD;
-          if (node->parent_->color_ == RD) {
-            node->parent_->color_ = BL;
+        if (s->color() == BL && (!s->left_ || s->left_->color() == BL) &&
+            (!s->right_ || s->right_->color() == BL)) {
+          s->set_color(RD);
+          if (node->parent()->color() == RD) {
+            node->parent()->set_color(BL);
             break;
           }
-          node = node->parent_;
+          node = node->parent();
         } else {
-          if (!s->right_ || s->right_->color_ == BL) {
-            s->color_ = RD;
-            s->left_->color_ = BL;
+          if (!s->right_ || s->right_->color() == BL) {
+            s->set_color(RD);
+            s->left_->set_color(BL);
             right_rotate(s);
-            s = node->parent_->right_;
+            s = node->parent()->right_;
           }
-          s->color_ = node->parent_->color_;
-          s->right_->color_ = BL;
-          node->parent_->color_ = BL;
-          left_rotate(node->parent_);
+          s->set_color(node->parent()->color());
+          s->right_->set_color(BL);
+          node->parent()->set_color(BL);
+          left_rotate(node->parent());
           break;
         }
       } else {
-        s = node->parent_->left_;
-        if (s->color_ == RD) {
-          std::swap(s->color_, node->parent_->color_);
-          right_rotate(node->parent_);
-          s = node->parent_->left_;
+        s = node->parent()->left_;
+        if (s->color() == RD) {
+          swap_colors(s, node->parent());
+          right_rotate(node->parent());
+          s = node->parent()->left_;
         }
-        if (s->color_ == BL && (!s->left_ || s->left_->color_ == BL) &&
-            (!s->right_ || s->right_->color_ == BL)) {
-          s->color_ = RD;
-          if (node->parent_->color_ == RD) {
-            node->parent_->color_ = BL;
+        if (s->color() == BL && (!s->left_ || s->left_->color() == BL) &&
+            (!s->right_ || s->right_->color() == BL)) {
+          s->set_color(RD);
+          if (node->parent()->color() == RD) {
+            node->parent()->set_color(BL);
             break;
           }
-          node = node->parent_;
+          node = node->parent();
         } else {
-          if (!s->left_ || s->left_->color_ == BL) {
-            s->color_ = RD;
-            s->right_->color_ = BL;
+          if (!s->left_ || s->left_->color() == BL) {
+            s->set_color(RD);
+            s->right_->set_color(BL);
             left_rotate(s);
-            s = node->parent_->left_;
+            s = node->parent()->left_;
           }
-          s->color_ = node->parent_->color_;
-          s->left_->color_ = BL;
-          node->parent_->color_ = BL;
-          right_rotate(node->parent_);
+          s->set_color(node->parent()->color());
+          s->left_->set_color(BL);
+          node->parent()->set_color(BL);
+          right_rotate(node->parent());
           break;
         }
       }
     }
-    root_->parent_->color_ = BL;
+    root_->parent()->set_color(BL);
   };
 
   void delete_all(Node_P node) {
     if (node == nullptr) return;
     delete_all(node->left_);
     delete_all(node->right_);
-    delete_node(node);
+    destroy_node(node);
   };
 
   Node_P copy(Node_P copy_node, Node_P parent) {
-    Node_P new_node = new RBTreeNode(copy_node);
+    Node_P new_node = create_node(copy_node);
     if (copy_node->left_) new_node->left_ = copy(copy_node->left_, new_node);
     if (copy_node->right_) new_node->right_ = copy(copy_node->right_, new_node);
-    new_node->parent_ = parent;
+    new_node->set_parent(parent);
     return new_node;
   };
 
-  class RBTreeNode {
+  class RBTreeNode : public SubtreeSize<OrderStatistics> {
    public:
     RBTreeNode()
         : data_(Key{}),
-          color_(RD),
-          parent_(nullptr),
+          parent_color_(RD),
           left_(nullptr),
           right_(nullptr){};
 
     RBTreeNode(const Key& value)
         : data_(value),
-          color_(RD),
-          parent_(nullptr),
+          parent_color_(RD),
           left_(nullptr),
           right_(nullptr){};
 
-    RBTreeNode(const Key&& value)
+    RBTreeNode(Key&& value)
         : data_(std::move(value)),
-          color_(RD),
-          parent_(nullptr),
+          parent_color_(RD),
+          left_(nullptr),
+          right_(nullptr){};
+
+    template <typename... Args>
+    explicit RBTreeNode(std::in_place_t, Args&&... args)
+        : data_(std::forward<Args>(args)...),
+          parent_color_(RD),
           left_(nullptr),
           right_(nullptr){};
 
     RBTreeNode(RBTreeNode* node)
-        : data_(node->data_),
-          color_(node->color_),
-          parent_(nullptr),
+        : SubtreeSize<OrderStatistics>(*node),
+          data_(node->data_),
+          parent_color_(node->color()),
           left_(nullptr),
           right_(nullptr){};
 
+    Node_P parent() const noexcept {
+      return reinterpret_cast<Node_P>(parent_color_ & ~kColorMask);
+    };
+
+    NodeColor color() const noexcept {
+      return static_cast<NodeColor>(parent_color_ & kColorMask);
+    };
+
+    void set_parent(Node_P parent) noexcept {
+      parent_color_ = reinterpret_cast<std::uintptr_t>(parent) |
+                      (parent_color_ & kColorMask);
+    };
+
+    void set_color(NodeColor color) noexcept {
+      parent_color_ = (parent_color_ & ~kColorMask) | color;
+    };
+
     Key data_;
-    NodeColor color_;
-    Node_P parent_;
+    // The parent pointer with the color in its lowest bit, which is always
+    // zero in a pointer to an aligned node. Saves the word that a separate
+    // color field costs after padding.
+    std::uintptr_t parent_color_;
     Node_P left_;
     Node_P right_;
 
     Node_P successor() noexcept {
       Node_P node = this;
-      if (node->color_ == RD &&
-          (node->parent_ == nullptr || node->parent_->parent_ == node)) {
+      if (node->color() == RD &&
+          (node->parent() == nullptr || node->parent()->parent() == node)) {
         return node->right_;
       } else if (node->right_ != nullptr) {
         node = node->right_;
         while (node->left_ != nullptr) node = node->left_;
       } else {
-        Node_P parent = node->parent_;
+        Node_P parent = node->parent();
         while (node == parent->right_) {
           node = parent;
-          parent = parent->parent_;
+          parent = parent->parent();
         }
         if (node->right_ != parent) node = parent;
       }
@@ -635,17 +1307,17 @@ class RBTree {
 
     Node_P predecessor() noexcept {
       Node_P node = this;
-      if (node->color_ == RD &&
-          (node->parent_ == nullptr || node->parent_->parent_ == node))
+      if (node->color() == RD &&
+          (node->parent() == nullptr || node->parent()->parent() == node))
         return node->right_;
       else if (node->left_ != nullptr) {
         node = node->left_;
         while (node->right_ != nullptr) node = node->right_;
       } else {
-        Node_P parent = node->parent_;
+        Node_P parent = node->parent();
         while (node == parent->left_) {
           node = parent;
-          parent = parent->parent_;
+          parent = parent->parent();
         }
         if (node->left_ != parent) node = parent;
       }
@@ -661,11 +1333,11 @@ class RBTree {
     RBTreeIterator(Node_P node) : node_(node){};
     reference operator*() noexcept { return node_->data_; };
 
-    bool operator==(const iterator& other) noexcept {
+    bool operator==(const iterator& other) const noexcept {
       return node_ == other.node_;
     };
 
-    bool operator!=(const iterator& other) noexcept {
+    bool operator!=(const iterator& other) const noexcept {
       return node_ != other.node_;
     };
 
@@ -738,8 +1410,104 @@ class RBTree {
     };
   };
 
+  // Owns one detached node. The node goes back to the pool it came from, which
+  // the handle keeps alive even if the source tree is gone.
+  class RBTreeNodeHandle {
+    friend RBTree;
+
+   public:
+    using value_type = Key;
+    using allocator_type = Allocator;
+
+    RBTreeNodeHandle() = default;
+
+    RBTreeNodeHandle(RBTreeNodeHandle&& other) noexcept
+        : node_(other.node_), pool_(std::move(other.pool_)) {
+      other.node_ = nullptr;
+    };
+
+    RBTreeNodeHandle& operator=(RBTreeNodeHandle&& other) noexcept {
+      if (this != &other) {
+        reset();
+        node_ = other.node_;
+        pool_ = std::move(other.pool_);
+        other.node_ = nullptr;
+      }
+      return *this;
+    };
+
+    ~RBTreeNodeHandle() { reset(); };
+
+    bool empty() const noexcept { return node_ == nullptr; };
+
+    explicit operator bool() const noexcept { return node_ != nullptr; };
+
+    allocator_type get_allocator() const { return pool_->get_allocator(); };
+
+    value_type& value() const { return node_->data_; };
+
+    // Keys of map nodes can be changed while the node is out of any tree.
+    template <typename V = Key>
+    std::remove_const_t<typename V::first_type>& key() const {
+      return const_cast<std::remove_const_t<typename V::first_type>&>(
+          node_->data_.first);
+    };
+
+    template <typename V = Key>
+    typename V::second_type& mapped() const {
+      return node_->data_.second;
+    };
+
+    void swap(RBTreeNodeHandle& other) noexcept {
+      std::swap(node_, other.node_);
+      std::swap(pool_, other.pool_);
+    };
+
+   private:
+    RBTreeNodeHandle(Node_P node, std::shared_ptr<node_pool> pool)
+        : node_(node), pool_(std::move(pool)){};
+
+    void reset() noexcept {
+      if (node_) {
+        node_->~RBTreeNode();
+        pool_->deallocate(node_);
+        node_ = nullptr;
+      }
+      pool_.reset();
+    };
+
+    void release() noexcept {
+      node_ = nullptr;
+      pool_.reset();
+    };
+
+    Node_P node_ = nullptr;
+    std::shared_ptr<node_pool> pool_;
+  };
+
   Node_P root_ = nullptr;
   size_type size_{};
+  std::shared_ptr<node_pool> pool_;
+};
+
+// Storage policies of set and map, naming the tree that holds the elements.
+// NodeStorage is RBTree with a pooled, pointer-linked node per element; see
+// ArenaStorage in s21_arena_tree.h for nodes packed into one array.
+struct NodeStorage {
+  template <typename Key, typename Compare, typename Allocator,
+            bool OrderStatistics>
+  using tree = RBTree<Key, Compare, Allocator, OrderStatistics>;
+};
+
+// Lets the free set operations of set, multiset and map reach the tree
+// inside them.
+struct SetAlgebra {
+  template <typename Container>
+  static Container combine(const Container& a, const Container& b,
+                           SetOperation op) {
+    using tree = typename Container::tree;
+    return Container(tree::combine(a.tree_, b.tree_, op));
+  };
 };
 }  // namespace s21
 
@@ -1,15 +1,43 @@
 #ifndef SRC_S21_VECTOR_H_
 #define SRC_S21_VECTOR_H_
 
+#include <algorithm>
+#include <cassert>
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
 #include <iterator>
 #include <limits>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
 #include <vector>
 
 namespace s21 {
-template <typename T>
+// Growth policy of Vector: when `required` elements no longer fit, the
+// capacity becomes Num / Den times the current one (or `required` if that is
+// still more), so any run of push_back calls costs amortized O(1).
+template <std::size_t Num, std::size_t Den>
+struct GeometricGrowth {
+  static_assert(Num > Den, "growth factor must be greater than one");
+
+  static std::size_t next_capacity(std::size_t current, std::size_t required) {
+    std::size_t grown = current + current / Den * (Num - Den) +
+                        current % Den * (Num - Den) / Den;
+    return grown < required ? required : grown;
+  }
+};
+
+using DoublingGrowth = GeometricGrowth<2, 1>;
+using HalfGrowth = GeometricGrowth<3, 2>;
+
+template <typename T, typename Allocator = std::allocator<T>,
+          typename Growth = DoublingGrowth>
 class Vector {
+  using alloc_traits = std::allocator_traits<Allocator>;
+  // elements that may be relocated with memcpy/memmove
+  using trivially_copyable = std::is_trivially_copyable<T>;
+
  public:
   /* TYPES */
   using value_type = T;
@@ -18,78 +46,94 @@ class Vector {
   using iterator = T *;
   using const_iterator = const T *;
   using size_type = size_t;
+  using allocator_type = Allocator;
 
   /*FUNCTIONS*/
   Vector() : size_(0), capacity_(0), arr_(nullptr) {}  // default constructor v
-  Vector(size_type n) : size_(n), capacity_(n), arr_(nullptr) {
-    arr_ = new value_type[size_];
-    for (size_type i = 0; i < size_; i++) {
-      arr_[i] = value_type();
+  explicit Vector(const Allocator &alloc)
+      : size_(0),
+        capacity_(0),
+        arr_(nullptr),
+        alloc_(alloc) {}  // constructor with an allocator v
+  Vector(size_type n, const Allocator &alloc = Allocator())
+      : size_(0), capacity_(n), arr_(nullptr), alloc_(alloc) {
+    arr_ = allocate_array(capacity_);
+    for (; size_ < n; size_++) {
+      alloc_traits::construct(alloc_, arr_ + size_);
     }
   }  // constructor v
 
-  Vector(std::initializer_list<value_type> const &items)
-      : Vector(items.size()) {
-    std::copy(items.begin(), items.end(), arr_);
+  Vector(std::initializer_list<value_type> const &items,
+         const Allocator &alloc = Allocator())
+      : size_(0), capacity_(items.size()), arr_(nullptr), alloc_(alloc) {
+    arr_ = allocate_array(capacity_);
+    construct_copy(items.begin(), items.end());
   }  // initializer list constructor v
 
-  Vector(const Vector &v) noexcept {
+  Vector(const Vector &v)
+      : size_(0),
+        capacity_(0),
+        arr_(nullptr),
+        alloc_(alloc_traits::select_on_container_copy_construction(v.alloc_)) {
     this->Copy_Vector(v);
   }  // copy construct v
 
   Vector(Vector &&v) noexcept
-      : size_(v.size_), capacity_(v.capacity_), arr_(v.arr_) {
+      : size_(v.size_),
+        capacity_(v.capacity_),
+        arr_(v.arr_),
+        alloc_(std::move(v.alloc_)) {
     v.size_ = 0;
     v.capacity_ = 0;
     v.arr_ = nullptr;
   }  // move constructor v
-  ~Vector() {
-    if (arr_) {
-      delete[] arr_;
-    }
-    size_ = 0;
-    capacity_ = 0;
-    arr_ = nullptr;
-  }  // destructor x
+  ~Vector() { free_storage(); }  // destructor x
 
   Vector &Copy_Vector(Vector &v) {
-    size_ = v.size_;
-    capacity_ = v.capacity_;
-    arr_ = new value_type[size_];
-    for (size_type i = 0; i < size_; i++) {
-      arr_[i] = value_type();
-    }
-    std::copy(v.arr_, v.arr_ + v.size_, arr_);
-
-    return *this;
+    return Copy_Vector(static_cast<const Vector &>(v));
   }
 
   Vector &Copy_Vector(const Vector &v) {
-    size_ = v.size_;
-    capacity_ = v.capacity_;
-    arr_ = new value_type[size_];
-    for (size_type i = 0; i < size_; i++) {
-      arr_[i] = value_type();
-    }
-    std::copy(v.arr_, v.arr_ + v.size_, arr_);
+    size_ = 0;
+    capacity_ = v.size_;
+    arr_ = allocate_array(capacity_);
+    construct_copy(v.arr_, v.arr_ + v.size_);
 
     return *this;
   }
-  Vector &operator=(Vector &&v) {
-    if (arr_ && arr_ != v.arr_) {
-      this->~Vector();
+  Vector &operator=(Vector &&v) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value) {
+    if (arr_ == v.arr_) return *this;
+    free_storage();
+    constexpr bool steal_always =
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value;
+    if constexpr (!steal_always) {
+      if (alloc_ != v.alloc_) {  // v's buffer cannot be freed by our allocator
+        arr_ = allocate_array(v.size_);
+        capacity_ = v.size_;
+        for (; size_ < v.size_; size_++) {
+          alloc_traits::construct(alloc_, arr_ + size_,
+                                  std::move(v.arr_[size_]));
+        }
+        v.free_storage();
+        return *this;
+      }
     }
-
-    if (arr_ != v.arr_) {
-      this->Copy_Vector(v);
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+      alloc_ = std::move(v.alloc_);
     }
+    std::swap(arr_, v.arr_);
+    std::swap(size_, v.size_);
+    std::swap(capacity_, v.capacity_);
 
     return *this;
 
-  }  // assignment operator v (moves Vector)
+  }  // assignment operator v (steals the buffer of v)
   Vector &operator=(const Vector &v) {
     if (arr_ && arr_ != v.arr_) {
-      this->~Vector();
+      free_storage();
     }
 
     if (arr_ != v.arr_) {
@@ -115,13 +159,18 @@ class Vector {
 
   }  // access specified const element with bounds checking v
   reference operator[](size_type pos) {
-    return at(pos);
-
-  }  // access specified element v
+#ifdef S21_CHECKED_ACCESS
+    assert(pos < size_ && "Vector index out of range");
+#endif
+    return arr_[pos];
+  }  // access specified element without bounds checking v
 
   const_reference operator[](size_type pos) const {
-    return at(pos);
-  }  // access specified const element v
+#ifdef S21_CHECKED_ACCESS
+    assert(pos < size_ && "Vector index out of range");
+#endif
+    return arr_[pos];
+  }  // access specified const element without bounds checking v
   const_reference front() { return arr_[0]; }  // access the first element v
   const_reference back() {
     return arr_[size_ - 1];
@@ -129,6 +178,9 @@ class Vector {
   iterator data() noexcept {
     return arr_;
   }  // direct access to the underlying array v
+  allocator_type get_allocator() const noexcept {
+    return alloc_;
+  }  // returns the allocator that owns the storage v
 
   /*ITERATORS*/
   iterator begin() noexcept {
@@ -145,24 +197,18 @@ class Vector {
   }  // returns a const iterator to the end x
 
   /*CAPACITY*/
-  bool empty() {
+  bool empty() const noexcept {
     return size_ == 0;
   }  // checks whether the container is empty x
   size_type size() const { return size_; }  // returns the number of elements x
-  size_type max_size() {
+  size_type max_size() const noexcept {
     return std::numeric_limits<size_type>::max() / sizeof(size_type) / 2;
   }  // returns the maximum possible number of elements x
   void reserve(size_type size) {
     if (size > this->max_size()) {
       throw std::length_error("size is bigger than max size of a container");
     } else if (size > capacity_) {
-      value_type *temp = new value_type[size]();
-      for (size_type i = 0; i < size_; i++) {
-        temp[i] = arr_[i];
-      }
-      delete[] arr_;
-      arr_ = temp;
-      capacity_ = size;
+      relocate(size);
     }
 
   }  // allocate storage of size elements and copies current array elements to a
@@ -172,108 +218,237 @@ class Vector {
   }  // returns the number of elements that can be held in currently allocated
   // storage x
   void shrink_to_fit() {
-    capacity_ = size_;
-    this->reserve(capacity_);
+    if (capacity_ > size_) {
+      relocate(size_);
+    }
 
   }  // reduces memory usage by freeing unused memory x
 
   /*MODIFIERS*/
-  void clear() noexcept { size_ = 0; }  // 	clears the contents x
+  void clear() noexcept {
+    destroy_range(arr_, arr_ + size_);
+    size_ = 0;
+  }  // 	clears the contents x
   iterator insert(iterator pos, const_reference value) {
     if (pos > end() || pos < begin()) {
       throw std::length_error("the pos is unreachable");
     }
-    auto new_index = std::distance(begin(), pos);
-
-    if (size_ >= capacity_ - 1) {
-      this->reserve((size_ == 0) ? 1 : capacity_ * 2);
-    }
-    for (long int i = size_; i > new_index; i--) {
-      arr_[i] = arr_[i - 1];
-    }
-    arr_[new_index] = value;
-    size_++;
-    return begin() + new_index;
+    return emplace(pos, value);
 
   }  // inserts elements into concrete pos and returns the iterator that points
   // to the new element x
   void erase(iterator pos) {
-    if (pos > end() || pos < begin()) {
+    if (pos >= end() || pos < begin()) {
       throw std::length_error("the pos is unreachable");
     }
     auto new_index = pos - begin();
-    for (size_type i = new_index; i < size_ - 1; i++) {
-      arr_[i] = arr_[i + 1];
+    if constexpr (trivially_copyable::value) {
+      std::memmove(pos, pos + 1, (size_ - new_index - 1) * sizeof(value_type));
+    } else {
+      for (size_type i = new_index; i < size_ - 1; i++) {
+        arr_[i] = std::move(arr_[i + 1]);
+      }
     }
-    size_--;
+    alloc_traits::destroy(alloc_, arr_ + --size_);
   }  // erases element at pos x
   void push_back(const_reference value) {
-    Vector<value_type> new_arr(size_ + 1);
-    new_arr[size_] = value;
-    for (size_type i = 0; i < size_; ++i) {
-      new_arr.arr_[i] = arr_[i];
-    }
-    size_++;
-    *this = std::move(new_arr);
-  }  // adds an element to the end x
+    emplace_back(value);
+  }  // adds an element to the end, reusing spare capacity x
   void pop_back() {
     if (size_ != 0) {
-      size_--;
+      alloc_traits::destroy(alloc_, arr_ + --size_);
     }
 
   }  // removes the last element x
   void swap(Vector &other) {
+    if constexpr (alloc_traits::propagate_on_container_swap::value) {
+      std::swap(alloc_, other.alloc_);
+    }
     std::swap(arr_, other.arr_);
     std::swap(size_, other.size_);
     std::swap(capacity_, other.capacity_);
   }  // 	swaps the contents x
 
+  // Constructs one element from args right in its slot. At the end or on
+  // reallocation nothing is moved through a temporary; in the middle of a
+  // full-capacity vector the value is built first, since args may refer to
+  // an element that the shift moves.
   template <class... Args>
   iterator emplace(const_iterator pos, Args &&...args) {
-    size_type shift = pos - arr_;  // calculates the shift required to insert
-                                   // the element at the given position
-    size_type shift_save = shift;  // for later use
-    size_type new_size = size_ + sizeof...(args);
-    size_type element_place =
-        shift + sizeof...(args);  // end position in the vector where new
-                                  // elements will be inserted
-    auto new_arr =
-        arr_;  // assigns the old array pointer to new_array initially
-
-    if (new_size > capacity_) {
-      capacity_ = new_size;
-      new_arr = new value_type[capacity_];
-      for (size_type i = 0; i < shift; i++) {
-        new_arr[i] = std::move(arr_[i]);
+    size_type shift = pos - arr_;
+    if (size_ == capacity_) {
+      size_type new_capacity = grow_capacity(size_ + 1);
+      iterator temp = allocate_array(new_capacity);
+      try {
+        alloc_traits::construct(alloc_, temp + shift,
+                                std::forward<Args>(args)...);
+      } catch (...) {
+        deallocate_array(temp, new_capacity);
+        throw;
+      }
+      try {
+        adopt_storage(temp, new_capacity, shift, 1);
+      } catch (...) {
+        alloc_traits::destroy(alloc_, temp + shift);
+        deallocate_array(temp, new_capacity);
+        throw;
       }
+    } else if (shift == size_) {
+      alloc_traits::construct(alloc_, arr_ + shift,
+                              std::forward<Args>(args)...);
+    } else {
+      value_type value(std::forward<Args>(args)...);
+      open_gap(shift, 1);
+      alloc_traits::construct(alloc_, arr_ + shift, std::move(value));
+    }
+    size_++;
+    return arr_ + shift;
+  }
+
+  template <class... Args>
+  reference emplace_back(Args &&...args) {
+    return *emplace(cend(), std::forward<Args>(args)...);
+  }
+
+  // Inserts one element per argument in front of pos.
+  template <class... Args>
+  iterator insert_many(const_iterator pos, Args &&...args) {
+    size_type shift = pos - arr_;
+    size_type count = sizeof...(args);
+    if (size_ + count > capacity_) {
+      relocate(grow_capacity(size_ + count));
     }
-    size_ = new_size;
-    for (auto i = new_size - 1; i >= element_place; i--) {
-      new_arr[i] = std::move(arr_[shift + i - element_place]);
+    open_gap(shift, count);
+    [[maybe_unused]] iterator slot = arr_ + shift;
+    (alloc_traits::construct(alloc_, slot++, std::forward<Args>(args)), ...);
+    size_ += count;
+    return arr_ + shift;
+  }
+
+  template <class... Args>
+  void insert_many_back(Args &&...args) {
+    insert_many(cend(), std::forward<Args>(args)...);
+  }
+
+ private:
+  // capacity to grow to when `required` elements must fit
+  size_type grow_capacity(size_type required) {
+    if (required > max_size()) {
+      throw std::length_error("size is bigger than max size of a container");
+    }
+    size_type next = Growth::next_capacity(capacity_, required);
+    return next > max_size() ? max_size() : next;
+  }
+
+  // raw storage for n elements; nothing is constructed in it
+  iterator allocate_array(size_type n) {
+    return n == 0 ? nullptr : alloc_traits::allocate(alloc_, n);
+  }
+
+  void deallocate_array(iterator arr, size_type n) noexcept {
+    if (arr) alloc_traits::deallocate(alloc_, arr, n);
+  }
+
+  void destroy_range(iterator first, iterator last) noexcept {
+    for (; first != last; ++first) alloc_traits::destroy(alloc_, first);
+  }
+
+  // copy-constructs [first, last) into the raw slots past size_
+  template <typename InputIt>
+  void construct_copy(InputIt first, InputIt last) {
+    if constexpr (trivially_copyable::value &&
+                  std::is_pointer<InputIt>::value) {
+      if (first != last) {
+        std::memcpy(arr_ + size_, first, (last - first) * sizeof(value_type));
+        size_ += last - first;
+      }
+    } else {
+      for (; first != last; ++first, ++size_) {
+        alloc_traits::construct(alloc_, arr_ + size_, *first);
+      }
     }
-    for (auto &&item : {std::forward<Args>(args)...}) {
-      new_arr[shift++] = std::move(item);
+  }
+
+  void relocate(size_type new_capacity) {
+    iterator temp = allocate_array(new_capacity);
+    try {
+      adopt_storage(temp, new_capacity, size_, 0);
+    } catch (...) {
+      deallocate_array(temp, new_capacity);
+      throw;
     }
+  }
 
-    if (arr_ != new_arr) {
-      delete[] arr_;
-      arr_ = new_arr;
+  // Moves the live elements into temp, leaving gap raw slots at gap_at, and
+  // makes temp the storage. Elements are copied instead when a throwing move
+  // would lose the old state; if that throws, temp holds nothing of ours.
+  void adopt_storage(iterator temp, size_type new_capacity, size_type gap_at,
+                     size_type gap) {
+    if constexpr (trivially_copyable::value) {
+      if (gap_at) std::memcpy(temp, arr_, gap_at * sizeof(value_type));
+      if (size_ > gap_at) {
+        std::memcpy(temp + gap_at + gap, arr_ + gap_at,
+                    (size_ - gap_at) * sizeof(value_type));
+      }
+    } else {
+      size_type i = 0;
+      try {
+        for (; i < size_; i++) {
+          alloc_traits::construct(alloc_, temp + i + (i < gap_at ? 0 : gap),
+                                  std::move_if_noexcept(arr_[i]));
+        }
+      } catch (...) {
+        for (size_type j = 0; j < i; j++) {
+          alloc_traits::destroy(alloc_, temp + j + (j < gap_at ? 0 : gap));
+        }
+        throw;
+      }
+      destroy_range(arr_, arr_ + size_);
     }
+    deallocate_array(arr_, capacity_);
+    arr_ = temp;
+    capacity_ = new_capacity;
+  }
 
-    return arr_ + shift_save;
+  // shifts [index, size_) right by count within the current capacity and
+  // leaves slots [index, index + count) unconstructed; size_ is unchanged
+  void open_gap(size_type index, size_type count) {
+    if (count == 0) return;
+    if constexpr (trivially_copyable::value) {
+      std::memmove(arr_ + index + count, arr_ + index,
+                   (size_ - index) * sizeof(value_type));
+    } else {
+      for (size_type i = size_; i-- > index;) {
+        if (i + count >= size_) {
+          alloc_traits::construct(alloc_, arr_ + i + count,
+                                  std::move(arr_[i]));
+        } else {
+          arr_[i + count] = std::move(arr_[i]);
+        }
+      }
+      destroy_range(arr_ + index, arr_ + std::min(index + count, size_));
+    }
   }
 
-  template <class... Args>
-  void emplace_back(Args &&...args) {
-    emplace(end(), args...);
+  void free_storage() noexcept {
+    destroy_range(arr_, arr_ + size_);
+    deallocate_array(arr_, capacity_);
+    size_ = 0;
+    capacity_ = 0;
+    arr_ = nullptr;
   }
 
- private:
   size_type size_;
   size_type capacity_;
   iterator arr_;  // pointer to the first element of Vector
+  Allocator alloc_{};
 };
 
+namespace pmr {
+template <typename T, typename Growth = DoublingGrowth>
+using Vector = s21::Vector<T, std::pmr::polymorphic_allocator<T>, Growth>;
+}  // namespace pmr
+
 template <typename T>
 class VectorConstIterator
     : public std::iterator<std::random_access_iterator_tag, T> {
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "../s21_btree_map.h"
+#include "../s21_btree_multiset.h"
+#include "../s21_btree_set.h"
+
+TEST(btreeSetTest, constructor) {
+  s21::btree_set<int> set1;
+  s21::btree_set<int> set2 = {3, 1, 2, 3};
+  s21::btree_set<int> set3 = set2;
+  s21::btree_set<int> set4 = std::move(set3);
+  EXPECT_TRUE(set1.empty());
+  EXPECT_EQ(set2.size(), 3U);
+  EXPECT_EQ(set4.size(), 3U);
+  EXPECT_TRUE(set3.empty());
+  int expected = 1;
+  for (int value : set4) EXPECT_EQ(value, expected++);
+  const s21::btree_set<int> set5(set2.begin(), set2.end());
+  EXPECT_EQ(*--set5.end(), 3);
+}
+
+TEST(btreeSetTest, insert_find_erase) {
+  s21::btree_set<int> s21_set;
+  std::set<int> std_set;
+  unsigned seed = 7;
+  for (int i = 0; i < 20000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>((seed >> 8) % 5000);
+    EXPECT_EQ(s21_set.insert(key).second, std_set.insert(key).second);
+  }
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  for (int key = -1; key < 5001; ++key) {
+    EXPECT_EQ(s21_set.contains(key), std_set.count(key) == 1);
+    auto lb = s21_set.lower_bound(key);
+    auto std_lb = std_set.lower_bound(key);
+    ASSERT_EQ(lb == s21_set.end(), std_lb == std_set.end());
+    if (std_lb != std_set.end()) {
+      EXPECT_EQ(*lb, *std_lb);
+    }
+  }
+  for (int key = 0; key < 5000; key += 2) {
+    auto it = s21_set.find(key);
+    if (it != s21_set.end()) s21_set.erase(it);
+    std_set.erase(key);
+  }
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  auto it = s21_set.begin();
+  for (int key : std_set) EXPECT_EQ(*it++, key);
+  EXPECT_TRUE(it == s21_set.end());
+  auto rit = s21_set.end();
+  for (auto std_it = std_set.rbegin(); std_it != std_set.rend(); ++std_it)
+    EXPECT_EQ(*--rit, *std_it);
+}
+
+TEST(btreeSetTest, erase_all) {
+  s21::btree_set<int> s21_set;
+  for (int i = 0; i < 3000; ++i) s21_set.insert(i);
+  for (int i = 0; i < 3000; ++i) {
+    s21_set.erase(s21_set.find((i * 7) % 3000));
+    EXPECT_EQ(s21_set.size(), 2999U - i);
+  }
+  EXPECT_TRUE(s21_set.begin() == s21_set.end());
+  s21_set.insert(1);
+  EXPECT_EQ(*s21_set.begin(), 1);
+}
+
+TEST(btreeSetTest, merge_and_transparent_lookup) {
+  s21::btree_set<std::string, std::less<>> a = {"a", "c", "e"};
+  s21::btree_set<std::string, std::less<>> b = {"b", "c", "d"};
+  a.merge(b);
+  EXPECT_EQ(a.size(), 5U);
+  EXPECT_EQ(b.size(), 1U);
+  EXPECT_TRUE(b.contains(std::string_view("c")));
+  EXPECT_EQ(*a.find(std::string_view("d")), "d");
+  EXPECT_EQ(a.count("z"), 0U);
+  auto res = a.insert_many("f", "a", "g");
+  ASSERT_EQ(res.size(), 3U);
+  EXPECT_TRUE(res[0].second);
+  EXPECT_FALSE(res[1].second);
+  EXPECT_EQ(*res[2].first, "g");
+}
+
+TEST(btreeMultisetTest, duplicates) {
+  s21::btree_multiset<int> s21_set;
+  std::multiset<int> std_set;
+  for (int i = 0; i < 10000; ++i) {
+    s21_set.insert(i % 37);
+    std_set.insert(i % 37);
+  }
+  EXPECT_EQ(s21_set.count(5), std_set.count(5));
+  auto range = s21_set.equal_range(10);
+  int n = 0;
+  for (auto it = range.first; it != range.second; ++it, ++n)
+    EXPECT_EQ(*it, 10);
+  EXPECT_EQ(static_cast<std::size_t>(n), std_set.count(10));
+  for (int i = 0; i < 200; ++i) s21_set.erase(s21_set.find(10));
+  EXPECT_EQ(s21_set.count(10), 70U);
+  s21::btree_multiset<int> other = {10, 10, 99};
+  s21_set.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(s21_set.count(10), 72U);
+  EXPECT_EQ(*--s21_set.end(), 99);
+}
+
+TEST(btreeMapTest, access) {
+  s21::btree_map<std::string, int> s21_map = {{"one", 1}, {"two", 2}};
+  s21_map["three"] = 3;
+  EXPECT_EQ(s21_map.at("two"), 2);
+  EXPECT_EQ(s21_map["three"], 3);
+  EXPECT_THROW(s21_map.at("four"), std::out_of_range);
+  EXPECT_FALSE(s21_map.insert("one", 10).second);
+  s21_map.insert_or_assign("one", 10);
+  EXPECT_EQ(s21_map.at("one"), 10);
+  EXPECT_TRUE(s21_map.emplace("four", 4).second);
+  EXPECT_EQ(s21_map.size(), 4U);
+  s21_map.erase(s21_map.find("two"));
+  EXPECT_FALSE(s21_map.contains("two"));
+  std::string keys;
+  for (const auto& item : s21_map) keys += item.first + " ";
+  EXPECT_EQ(keys, "four one three ");
+}
+
+TEST(btreeMapTest, matches_std_map) {
+  s21::btree_map<int, std::string> s21_map;
+  std::map<int, std::string> std_map;
+  for (int i = 0; i < 5000; ++i) {
+    int key = (i * 7919) % 4001;
+    s21_map[key] += "x";
+    std_map[key] += "x";
+  }
+  for (int i = 0; i < 4001; i += 3) {
+    auto it = s21_map.find(i);
+    if (it != s21_map.end()) s21_map.erase(it);
+    std_map.erase(i);
+  }
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  auto it = s21_map.begin();
+  for (const auto& item : std_map) {
+    EXPECT_EQ((*it).first, item.first);
+    EXPECT_EQ((*it).second, item.second);
+    ++it;
+  }
+  s21::btree_map<int, std::string> copy(s21_map);
+  EXPECT_EQ(copy.size(), s21_map.size());
+  EXPECT_EQ(copy.at(1), std_map.at(1));
+}
+
+TEST(btreeSetTest, hinted_insert) {
+  int compares = 0;
+  auto less = [&compares](int a, int b) {
+    ++compares;
+    return a < b;
+  };
+  s21::btree_set<int, decltype(less)> s21_set(less);
+  for (int i = 0; i < 1000; ++i) s21_set.insert(s21_set.end(), i);
+  EXPECT_LE(compares, 2 * 1000);
+  auto it = s21_set.insert(s21_set.find(500), 500);
+  EXPECT_EQ(*it, 500);
+  it = s21_set.emplace_hint(s21_set.begin(), 2000);
+  EXPECT_EQ(*it, 2000);
+  EXPECT_EQ(s21_set.size(), 1001U);
+  int expected = 0;
+  for (int value : s21_set) {
+    EXPECT_EQ(value, expected);
+    expected = expected == 999 ? 2000 : expected + 1;
+  }
+}
+
+TEST(btreeMultisetTest, insert_stored_value) {
+  s21::btree_multiset<std::string> s21_set;
+  for (int i = 0; i < 500; ++i) s21_set.insert(std::string(30, 'a'));
+  for (int i = 0; i < 500; ++i) s21_set.insert(*--s21_set.end());
+  for (int i = 0; i < 500; ++i)
+    s21_set.emplace_hint(s21_set.begin(), *s21_set.begin());
+  EXPECT_EQ(s21_set.count(std::string(30, 'a')), 1500U);
+}
+
+TEST(btreeMapTest, emplace_in_place) {
+  struct Counted {
+    Counted(int v, int* m) : value(v), moves(m){};
+    Counted(Counted&& other) noexcept
+        : value(other.value), moves(other.moves) {
+      ++*moves;
+    };
+    int value;
+    int* moves;
+  };
+  int moves = 0;
+  s21::btree_map<int, Counted> s21_map;
+  s21_map.emplace(1, Counted(2, &moves));
+  moves = 0;
+  s21_map.emplace(2, Counted(4, &moves));
+  s21_map.emplace_hint(s21_map.end(), 3, Counted(6, &moves));
+  EXPECT_FALSE(s21_map.emplace(2, Counted(0, &moves)).second);
+  EXPECT_EQ(moves, 2);
+  int key = 1;
+  for (const auto& item : s21_map) {
+    EXPECT_EQ(item.first, key);
+    EXPECT_EQ(item.second.value, 2 * key++);
+  }
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../s21_flat_map.h"
+#include "../s21_flat_multiset.h"
+#include "../s21_flat_set.h"
+
+TEST(flatSetTest, constructor) {
+  s21::flat_set<int> set1;
+  s21::flat_set<int> set2 = {3, 1, 2, 3};
+  s21::flat_set<int> set3 = set2;
+  s21::flat_set<int> set4 = std::move(set3);
+  EXPECT_TRUE(set1.empty());
+  EXPECT_EQ(set2.size(), 3U);
+  EXPECT_EQ(set4.size(), 3U);
+  EXPECT_TRUE(set3.empty());
+  int expected = 1;
+  for (int value : set4) EXPECT_EQ(value, expected++);
+  const s21::flat_set<int> set5(set2.begin(), set2.end());
+  EXPECT_EQ(*(set5.end() - 1), 3);
+}
+
+TEST(flatSetTest, insert_find_erase) {
+  s21::flat_set<int> s21_set;
+  std::set<int> std_set;
+  unsigned seed = 7;
+  for (int i = 0; i < 5000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>((seed >> 8) % 2000);
+    EXPECT_EQ(s21_set.insert(key).second, std_set.insert(key).second);
+  }
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  for (int key = -1; key < 2001; ++key) {
+    EXPECT_EQ(s21_set.contains(key), std_set.count(key) == 1);
+    auto lb = s21_set.lower_bound(key);
+    auto std_lb = std_set.lower_bound(key);
+    ASSERT_EQ(lb == s21_set.end(), std_lb == std_set.end());
+    if (std_lb != std_set.end()) {
+      EXPECT_EQ(*lb, *std_lb);
+    }
+  }
+  for (int key = 0; key < 2000; key += 2) {
+    auto it = s21_set.find(key);
+    if (it != s21_set.end()) s21_set.erase(it);
+    std_set.erase(key);
+  }
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  auto it = s21_set.begin();
+  for (int key : std_set) EXPECT_EQ(*it++, key);
+  auto hint = s21_set.insert(s21_set.lower_bound(10), 10);
+  EXPECT_EQ(*hint, 10);
+  EXPECT_EQ(*(hint + 1), 11);
+}
+
+TEST(flatSetTest, bulk_insert) {
+  s21::flat_set<int> s21_set = {5, 15, 25};
+  std::set<int> std_set = {5, 15, 25};
+  std::vector<int> batch;
+  for (int i = 0; i < 1000; ++i) batch.push_back((i * 37) % 300);
+  s21_set.insert(batch.begin(), batch.end());
+  std_set.insert(batch.begin(), batch.end());
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  EXPECT_TRUE(std::equal(s21_set.begin(), s21_set.end(), std_set.begin()));
+  s21_set.reserve(1000);
+  EXPECT_GE(s21_set.capacity(), 1000U);
+  s21_set.shrink_to_fit();
+  EXPECT_EQ(s21_set.capacity(), s21_set.size());
+  EXPECT_EQ(*s21_set.find(299), 299);
+}
+
+TEST(flatSetTest, merge_and_transparent_lookup) {
+  s21::flat_set<std::string, std::less<>> a = {"a", "c", "e"};
+  s21::flat_set<std::string, std::less<>> b = {"b", "c", "d"};
+  a.merge(b);
+  EXPECT_EQ(a.size(), 5U);
+  EXPECT_EQ(b.size(), 1U);
+  EXPECT_TRUE(b.contains(std::string_view("c")));
+  EXPECT_EQ(*a.find(std::string_view("d")), "d");
+  EXPECT_EQ(a.count("z"), 0U);
+  auto res = a.insert_many("f", "a", "g");
+  ASSERT_EQ(res.size(), 3U);
+  EXPECT_TRUE(res[0].second);
+  EXPECT_EQ(*res[0].first, "f");
+  EXPECT_FALSE(res[1].second);
+  EXPECT_EQ(*res[2].first, "g");
+}
+
+TEST(flatMultisetTest, duplicates) {
+  s21::flat_multiset<int> s21_set;
+  std::multiset<int> std_set;
+  std::vector<int> batch;
+  for (int i = 0; i < 10000; ++i) batch.push_back(i % 37);
+  s21_set.insert(batch.begin(), batch.end());
+  std_set.insert(batch.begin(), batch.end());
+  EXPECT_EQ(s21_set.count(5), std_set.count(5));
+  auto range = s21_set.equal_range(10);
+  EXPECT_EQ(static_cast<std::size_t>(range.second - range.first),
+            std_set.count(10));
+  for (int i = 0; i < 200; ++i) s21_set.erase(s21_set.find(10));
+  EXPECT_EQ(s21_set.count(10), 70U);
+  s21::flat_multiset<int> other = {10, 10, 99};
+  s21_set.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(s21_set.count(10), 72U);
+  EXPECT_EQ(*(s21_set.end() - 1), 99);
+  auto res = s21_set.insert_many(7, 7);
+  EXPECT_EQ(res[0].first + 1, res[1].first);
+}
+
+TEST(flatMapTest, access) {
+  s21::flat_map<std::string, int> s21_map = {{"one", 1}, {"two", 2}};
+  s21_map["three"] = 3;
+  EXPECT_EQ(s21_map.at("two"), 2);
+  EXPECT_EQ(s21_map["three"], 3);
+  EXPECT_THROW(s21_map.at("four"), std::out_of_range);
+  EXPECT_FALSE(s21_map.insert("one", 10).second);
+  s21_map.insert_or_assign("one", 10);
+  EXPECT_EQ(s21_map.at("one"), 10);
+  EXPECT_TRUE(s21_map.emplace("four", 4).second);
+  EXPECT_EQ(s21_map.size(), 4U);
+  s21_map.erase(s21_map.find("two"));
+  EXPECT_FALSE(s21_map.contains("two"));
+  s21_map.find("four")->second = 44;
+  std::string keys;
+  for (const auto& item : s21_map) keys += item.first + " ";
+  EXPECT_EQ(keys, "four one three ");
+  const auto& const_map = s21_map;
+  EXPECT_EQ(const_map.begin()->second, 44);
+  auto range = const_map.equal_range("seven");
+  EXPECT_EQ(range.first, range.second);
+  EXPECT_EQ((*range.first).first, "three");
+}
+
+TEST(flatMapTest, matches_std_map) {
+  s21::flat_map<int, std::string> s21_map;
+  std::map<int, std::string> std_map;
+  std::vector<std::pair<const int, std::string>> batch;
+  for (int i = 0; i < 5000; ++i) {
+    int key = (i * 7919) % 4001;
+    batch.emplace_back(key, std::to_string(i));
+    if (i % 5 == 0) {
+      s21_map[key] += "x";
+      std_map[key] += "x";
+    }
+  }
+  s21_map.insert(batch.begin(), batch.end());
+  std_map.insert(batch.begin(), batch.end());
+  for (int i = 0; i < 4001; i += 3) {
+    auto it = s21_map.find(i);
+    if (it != s21_map.end()) s21_map.erase(it);
+    std_map.erase(i);
+  }
+  ASSERT_EQ(s21_map.size(), std_map.size());
+  auto it = s21_map.begin();
+  for (const auto& item : std_map) {
+    EXPECT_EQ((*it).first, item.first);
+    EXPECT_EQ(it->second, item.second);
+    ++it;
+  }
+  s21::flat_map<int, std::string> copy(s21_map);
+  EXPECT_EQ(copy.size(), s21_map.size());
+  EXPECT_EQ(copy.at(1), std_map.at(1));
+  s21::flat_map<int, std::string> other = {{1, "kept"}, {-1, "moved"}};
+  copy.merge(other);
+  EXPECT_EQ(copy.begin()->second, "moved");
+  ASSERT_EQ(other.size(), 1U);
+  EXPECT_EQ(other.at(1), "kept");
+}
+
+TEST(flatMapTest, iterator_ordering) {
+  s21::flat_map<int, int> s21_map = {{1, 10}, {2, 20}, {3, 30}, {4, 40}};
+  s21::flat_map<int, int>::iterator it = s21_map.begin();
+  s21::flat_map<int, int>::const_iterator cit = s21_map.begin();
+  EXPECT_TRUE(it == cit);
+  EXPECT_TRUE(cit == it);
+  EXPECT_FALSE(it != cit);
+  auto last = 3 + it;
+  EXPECT_EQ((*last).second, 40);
+  EXPECT_TRUE(last > it);
+  EXPECT_TRUE(last > cit);
+  EXPECT_TRUE(cit < last);
+  EXPECT_TRUE(it <= cit);
+  EXPECT_TRUE(cit >= it);
+  EXPECT_FALSE(it > it);
+  EXPECT_TRUE(last >= last);
+  EXPECT_EQ(last - cit, 3);
+  EXPECT_EQ(cit - last, -3);
+  EXPECT_EQ(s21_map.end() - it, 4);
+  EXPECT_EQ(it[2].first, 3);
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
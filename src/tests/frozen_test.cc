@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <string_view>
+
+#include "../s21_frozen_map.h"
+#include "../s21_frozen_set.h"
+#include "../s21_map.h"
+#include "../s21_set.h"
+
+TEST(frozenSetTest, constructor) {
+  s21::frozen_set<int> set1;
+  s21::frozen_set<int> set2 = {3, 1, 2, 3};
+  s21::frozen_set<int> set3 = set2;
+  s21::frozen_set<int> set4 = std::move(set3);
+  EXPECT_TRUE(set1.empty());
+  EXPECT_TRUE(set1.begin() == set1.end());
+  EXPECT_TRUE(set1.find(1) == set1.end());
+  EXPECT_EQ(set2.size(), 3U);
+  EXPECT_EQ(set4.size(), 3U);
+  EXPECT_TRUE(set3.empty());
+  int expected = 1;
+  for (int value : set4) EXPECT_EQ(value, expected++);
+  EXPECT_EQ(*--set4.end(), 3);
+}
+
+TEST(frozenSetTest, matches_std_set) {
+  for (int n : {1, 2, 7, 8, 100, 1000, 4097}) {
+    s21::set<int> source;
+    std::set<int> std_set;
+    for (int i = 0; i < n; ++i) {
+      source.insert(i * 3);
+      std_set.insert(i * 3);
+    }
+    s21::frozen_set<int> frozen(source);
+    ASSERT_EQ(frozen.size(), std_set.size());
+    auto it = frozen.begin();
+    for (int key : std_set) EXPECT_EQ(*it++, key);
+    EXPECT_TRUE(it == frozen.end());
+    for (int key = -1; key <= 3 * n; ++key) {
+      EXPECT_EQ(frozen.contains(key), std_set.count(key) == 1);
+      auto lb = frozen.lower_bound(key);
+      auto std_lb = std_set.lower_bound(key);
+      ASSERT_EQ(lb == frozen.end(), std_lb == std_set.end());
+      if (std_lb != std_set.end()) {
+        EXPECT_EQ(*lb, *std_lb);
+      }
+      auto ub = frozen.upper_bound(key);
+      auto std_ub = std_set.upper_bound(key);
+      ASSERT_EQ(ub == frozen.end(), std_ub == std_set.end());
+      if (std_ub != std_set.end()) {
+        EXPECT_EQ(*ub, *std_ub);
+      }
+    }
+  }
+}
+
+TEST(frozenSetTest, transparent_lookup) {
+  s21::set<std::string, std::less<>> source = {"beta", "alpha", "gamma"};
+  s21::frozen_set<std::string, std::less<>> frozen(source);
+  EXPECT_TRUE(frozen.contains(std::string_view("alpha")));
+  EXPECT_EQ(frozen.count("delta"), 0U);
+  EXPECT_EQ(frozen.find("gamma")->size(), 5U);
+  auto range = frozen.equal_range("beta");
+  EXPECT_EQ(*range.first, "beta");
+  EXPECT_EQ(*range.second, "gamma");
+  range = frozen.equal_range("b");
+  EXPECT_TRUE(range.first == range.second);
+}
+
+TEST(frozenMapTest, access) {
+  s21::map<std::string, int> source = {{"one", 1}, {"two", 2}, {"three", 3}};
+  s21::frozen_map<std::string, int> frozen(source);
+  source.clear();
+  EXPECT_EQ(frozen.at("two"), 2);
+  EXPECT_THROW(frozen.at("four"), std::out_of_range);
+  EXPECT_TRUE(frozen.contains("three"));
+  EXPECT_EQ(frozen.find("one")->second, 1);
+  std::string keys;
+  for (const auto& item : frozen) keys += item.first + " ";
+  EXPECT_EQ(keys, "one three two ");
+  s21::frozen_map<std::string, int> copy;
+  copy = frozen;
+  EXPECT_EQ((*copy.lower_bound("p")).first, "three");
+  EXPECT_EQ(copy.size(), 3U);
+  s21::frozen_map<std::string, int> listed = {{"b", 1}, {"a", 2}, {"b", 3}};
+  EXPECT_EQ(listed.size(), 2U);
+  EXPECT_EQ(listed.at("b"), 1);
+  EXPECT_EQ((*listed.begin()).first, "a");
+}
+
+TEST(frozenMapTest, pmr_allocator) {
+  std::pmr::monotonic_buffer_resource first, second;
+  s21::map<int, int> source;
+  for (int i = 0; i < 1000; ++i) source.insert(i, -i);
+  s21::pmr::frozen_map<int, int> a(source, &first);
+  s21::pmr::frozen_map<int, int> b({{5, 5}}, std::less<int>(), &second);
+  b = std::move(a);
+  EXPECT_EQ(b.get_allocator().resource(), &second);
+  EXPECT_EQ(b.size(), 1000U);
+  EXPECT_EQ(b.at(999), -999);
+}
+
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
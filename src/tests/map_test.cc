@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
 #include <map>
+#include <memory>
+#include <string_view>
 
 #include "../s21_containers.h"
 
@@ -1358,6 +1360,285 @@ TEST(mapTest, insert_many_3) {
   EXPECT_EQ(s21_map.at("!"), s21_exm.at("!"));
 }
 
+TEST(mapTest, lookup_ignores_mapped_value) {
+  s21::map<int, std::string> s21_map;
+  for (int i = 0; i < 1000; ++i) s21_map.insert(i, std::to_string(i * 7));
+
+  EXPECT_EQ(s21_map.size(), 1000U);
+  EXPECT_TRUE(s21_map.contains(500));
+  EXPECT_FALSE(s21_map.contains(1000));
+  EXPECT_EQ(s21_map.at(999), "6993");
+  EXPECT_FALSE(s21_map.insert(10, "other").second);
+  EXPECT_EQ(s21_map.at(10), "70");
+
+  auto res = s21_map.insert_or_assign(10, "other");
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ((*res.first).second, "other");
+  EXPECT_EQ(s21_map.size(), 1000U);
+}
+
+TEST(mapTest, custom_compare) {
+  s21::map<std::string, int, std::greater<std::string>> s21_map = {
+      {"a", 1}, {"c", 3}, {"b", 2}};
+  std::map<std::string, int, std::greater<std::string>> std_map = {
+      {"a", 1}, {"c", 3}, {"b", 2}};
+  auto s21_it = s21_map.begin();
+  for (auto std_it = std_map.begin(); std_it != std_map.end();
+       std_it++, s21_it++) {
+    EXPECT_EQ((*s21_it).first, std_it->first);
+    EXPECT_EQ((*s21_it).second, std_it->second);
+  }
+  EXPECT_EQ(s21_map.at("b"), 2);
+  EXPECT_TRUE(s21_map.value_comp()({"b", 0}, {"a", 0}));
+  EXPECT_TRUE(s21_map.key_comp()("b", "a"));
+}
+
+struct CountedKey {
+  static inline int constructed = 0;
+  int id;
+  CountedKey(int i = 0) : id(i) { ++constructed; }
+  CountedKey(const CountedKey &other) : id(other.id) { ++constructed; }
+};
+
+struct CountedLess {
+  using is_transparent = void;
+  bool operator()(const CountedKey &a, const CountedKey &b) const {
+    return a.id < b.id;
+  }
+  bool operator()(const CountedKey &a, int b) const { return a.id < b; }
+  bool operator()(int a, const CountedKey &b) const { return a < b.id; }
+};
+
+TEST(mapTest, transparent_lookup) {
+  s21::map<std::string, int, std::less<>> s21_map = {
+      {"one", 1}, {"two", 2}, {"three", 3}};
+  std::string_view two = "two";
+
+  EXPECT_TRUE(s21_map.contains(two));
+  EXPECT_FALSE(s21_map.contains("four"));
+  EXPECT_EQ((*s21_map.find(two)).second, 2);
+  EXPECT_EQ(s21_map.find("four"), s21_map.end());
+  EXPECT_EQ(s21_map.count("one"), 1U);
+  EXPECT_EQ(s21_map.count("four"), 0U);
+  EXPECT_EQ((*s21_map.lower_bound("p")).first, "three");
+  EXPECT_EQ((*s21_map.upper_bound("three")).first, "two");
+  auto range = s21_map.equal_range(two);
+  EXPECT_EQ((*range.first).first, "two");
+  EXPECT_EQ(range.second, s21_map.end());
+}
+
+TEST(mapTest, transparent_lookup_builds_no_key) {
+  s21::map<CountedKey, int, CountedLess> s21_map;
+  for (int i = 0; i < 100; ++i) s21_map.insert(CountedKey(i), i);
+  int constructed = CountedKey::constructed;
+
+  for (int i = 0; i < 100; ++i) EXPECT_TRUE(s21_map.contains(i));
+  EXPECT_EQ((*s21_map.find(42)).second, 42);
+  EXPECT_EQ(s21_map.count(100), 0U);
+  EXPECT_EQ(CountedKey::constructed, constructed);
+}
+
+TEST(mapTest, pmr_monotonic_arena) {
+  char buffer[1 << 16];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  s21::pmr::map<int, double> s21_map(&arena);
+  for (int i = 0; i < 100; ++i) s21_map.insert(i, i * 0.5);
+  EXPECT_EQ(s21_map.size(), 100U);
+  EXPECT_EQ(s21_map.at(42), 21.0);
+  EXPECT_EQ(s21_map.get_allocator().resource(), &arena);
+}
+
+TEST(mapTest, subscript_single_descent) {
+  int compares = 0;
+  auto less = [&compares](int a, int b) {
+    ++compares;
+    return a < b;
+  };
+  s21::map<int, std::unique_ptr<int>, decltype(less)> s21_map(less);
+  for (int i = 0; i < 1000; i += 2) s21_map[i] = std::make_unique<int>(i);
+  compares = 0;
+  s21_map.find(501);
+  const int find_compares = compares;
+  compares = 0;
+  s21_map[501] = std::make_unique<int>(501);
+  EXPECT_LE(compares, find_compares + 2);
+  EXPECT_EQ(*s21_map[501], 501);
+  EXPECT_EQ(*s21_map.at(500), 500);
+  EXPECT_EQ(s21_map.size(), 501U);
+
+  s21::arena::map<int, std::unique_ptr<int>> arena_map;
+  arena_map[2] = std::make_unique<int>(2);
+  arena_map[1] = std::make_unique<int>(1);
+  EXPECT_EQ(*(*arena_map.begin()).second, 1);
+
+  s21::map<std::string, int> words = {{"a", 1}};
+  EXPECT_FALSE(words.insert_or_assign("a", 2).second);
+  EXPECT_TRUE(words.insert_or_assign("b", 3).second);
+  EXPECT_EQ(words.at("a"), 2);
+  EXPECT_EQ((*--words.end()).second, 3);
+}
+
+TEST(mapTest, node_handle_change_key) {
+  s21::map<int, std::string> map = {{1, "one"}, {2, "two"}, {3, "three"}};
+  const std::string* two = &map.at(2);
+  auto nh = map.extract(2);
+  EXPECT_FALSE(map.contains(2));
+  nh.key() = 20;
+  nh.mapped() += "nty";
+  auto res = map.insert(std::move(nh));
+  EXPECT_TRUE(res.inserted);
+  EXPECT_EQ(&map.at(20), two);
+  EXPECT_EQ(map.at(20), "twonty");
+  EXPECT_EQ((*--map.end()).first, 20);
+}
+
+TEST(mapTest, node_handle_move_between_maps) {
+  s21::map<int, std::string> map1 = {{1, "one"}, {2, "two"}};
+  s21::map<int, std::string> map2(map1.pool());
+  const std::string* two = &map1.at(2);
+  s21::NodePoolStats before = map1.pool_stats();
+  auto res = map2.insert(map1.extract(2));
+  EXPECT_TRUE(res.inserted);
+  EXPECT_EQ(&map2.at(2), two);
+  EXPECT_EQ(map1.pool_stats().in_use, before.in_use);
+  EXPECT_EQ(map1.pool_stats().capacity, before.capacity);
+
+  s21::map<int, std::string> other;
+  res = other.insert(map2.extract(2));
+  EXPECT_TRUE(res.inserted);
+  EXPECT_NE(&other.at(2), two);
+  EXPECT_EQ(other.at(2), "two");
+  EXPECT_EQ(other.pool_stats().in_use, 1U);
+  EXPECT_EQ(map1.pool_stats().in_use, before.in_use - 1);
+}
+
+TEST(mapTest, emplace_hint) {
+  s21::map<int, std::string> map;
+  for (int i = 0; i < 100; ++i) {
+    map.emplace_hint(map.end(), i, std::string(3, 'a' + i % 26));
+  }
+  auto it = map.insert(map.find(50), {50, "dup"});
+  EXPECT_EQ((*it).second, "yyy");
+  it = map.emplace_hint(map.begin(), -5, "neg");
+  EXPECT_EQ(it, map.begin());
+  EXPECT_EQ(map.size(), 101U);
+  int expected = -5;
+  for (auto& kv : map) {
+    EXPECT_EQ(kv.first, expected);
+    expected = expected < 0 ? 0 : expected + 1;
+  }
+}
+
+TEST(mapTest, build_from_sorted_range) {
+  std::vector<std::pair<int, std::string>> items;
+  for (int i = 0; i < 100; ++i) items.push_back({i, std::to_string(i)});
+  items.push_back({99, "dup"});
+  s21::map<int, std::string> map(items.begin(), items.end());
+  EXPECT_EQ(map.size(), 100U);
+  EXPECT_EQ(map.at(99), "99");
+  EXPECT_EQ(map.at(42), "42");
+  map[100] = "100";
+  EXPECT_EQ((*--map.end()).second, "100");
+}
+
+TEST(mapTest, emplace) {
+  s21::map<int, std::string> map;
+  auto res = map.emplace(1, "one");
+  EXPECT_TRUE(res.second);
+  res = map.emplace(std::piecewise_construct, std::forward_as_tuple(2),
+                    std::forward_as_tuple(3, 'x'));
+  EXPECT_EQ((*res.first).second, "xxx");
+  res = map.emplace(1, "uno");
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(map.at(1), "one");
+  EXPECT_EQ(map.size(), 2U);
+}
+
+TEST(mapTest, order_statistics) {
+  s21::map<std::string, int, std::less<>,
+           std::allocator<std::pair<const std::string, int>>, true>
+      map = {{"b", 2}, {"d", 4}, {"a", 1}, {"c", 3}};
+  EXPECT_EQ((*map.nth(2)).first, "c");
+  EXPECT_EQ(map.rank("c"), 2U);
+  EXPECT_EQ(map.rank(std::string_view("zz")), 4U);
+  EXPECT_EQ(map.count_range("b", "d"), 2U);
+  map.erase(map.find("a"));
+  EXPECT_EQ((*map.nth(0)).second, 2);
+}
+
+TEST(mapTest, split_and_join) {
+  s21::map<std::string, int> low = {{"a", 1}, {"c", 3}, {"e", 5}, {"g", 7}};
+  const int* e = &low.at("e");
+  s21::map<std::string, int> high = low.split("d");
+  EXPECT_EQ(low.size(), 2U);
+  EXPECT_EQ(high.size(), 2U);
+  EXPECT_FALSE(low.contains("e"));
+  EXPECT_EQ(&high.at("e"), e);
+  high["z"] = 26;
+  low.join(high);
+  EXPECT_TRUE(high.empty());
+  EXPECT_EQ(low.size(), 5U);
+  EXPECT_EQ(&low.at("e"), e);
+  EXPECT_EQ((*--low.end()).second, 26);
+}
+
+TEST(mapTest, set_algebra) {
+  s21::map<std::string, int> a = {{"a", 1}, {"b", 2}, {"c", 3}};
+  s21::map<std::string, int> b = {{"b", 20}, {"c", 30}, {"d", 40}};
+  s21::map<std::string, int> both = s21::set_union(a, b);
+  EXPECT_EQ(both.size(), 4U);
+  EXPECT_EQ(both.at("b"), 2);
+  EXPECT_EQ(both.at("d"), 40);
+  s21::map<std::string, int> common = s21::set_intersection(b, a);
+  EXPECT_EQ(common.size(), 2U);
+  EXPECT_EQ(common.at("c"), 30);
+  EXPECT_EQ(s21::set_difference(a, b).size(), 1U);
+  EXPECT_TRUE(s21::set_difference(a, b).contains("a"));
+  EXPECT_EQ(s21::set_symmetric_difference(a, b).size(), 2U);
+}
+
+TEST(mapTest, arena_storage) {
+  s21::arena::map<std::string, int> s21_map = {{"b", 2}, {"a", 1}};
+  std::map<std::string, int> std_map = {{"b", 2}, {"a", 1}};
+  for (int i = 0; i < 2000; ++i) {
+    std::string key = std::to_string((i * 31) % 701);
+    s21_map[key] += i;
+    std_map[key] += i;
+  }
+  s21_map.insert_or_assign("a", 10);
+  std_map["a"] = 10;
+  EXPECT_EQ(s21_map.at("a"), 10);
+  EXPECT_THROW(s21_map.at("zz"), std::out_of_range);
+  for (int i = 0; i < 701; i += 2) {
+    auto it = s21_map.find(std::to_string(i));
+    if (it != s21_map.end()) s21_map.erase(it);
+    std_map.erase(std::to_string(i));
+  }
+  s21::arena::map<std::string, int> copy = s21_map;
+  ASSERT_EQ(copy.size(), std_map.size());
+  auto it = copy.begin();
+  for (const auto& item : std_map) {
+    EXPECT_EQ((*it).first, item.first);
+    EXPECT_EQ((*it).second, item.second);
+    ++it;
+  }
+}
+
+TEST(mapTest, arena_storage_references) {
+  s21::arena::map<int, std::string> s21_map;
+  for (int i = 0; i < 15; ++i) s21_map[i] = std::to_string(i);
+  auto it = s21_map.find(3);
+  const std::string* three = &s21_map.at(3);
+  std::size_t capacity = s21_map.pool_stats().capacity;
+  std::string value = s21_map[3];
+  s21_map[100] = value;
+  ASSERT_GT(s21_map.pool_stats().capacity, capacity);
+  EXPECT_NE(&s21_map.at(3), three);
+  EXPECT_EQ(&(*it).second, &s21_map.at(3));
+  EXPECT_EQ(s21_map.at(100), "3");
+}
+
 int main(int argc, char *argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -546,6 +546,153 @@ TEST(multisetTest, insert_many_5) {
   }
 }
 
+TEST(multisetTest, custom_compare) {
+  s21::multiset<int, std::greater<int>> s21_set = {1, 5, 3, 3, 4, 2, 5};
+  std::multiset<int, std::greater<int>> std_set = {1, 5, 3, 3, 4, 2, 5};
+  EXPECT_EQ(s21_set.size(), std_set.size());
+  auto s21_it = s21_set.begin();
+  for (auto std_it = std_set.begin(); std_it != std_set.end();
+       std_it++, s21_it++) {
+    EXPECT_EQ(*s21_it, *std_it);
+  }
+  EXPECT_EQ(*s21_set.lower_bound(4), 4);
+  EXPECT_EQ(*s21_set.upper_bound(4), 3);
+}
+
+TEST(multisetTest, pmr_monotonic_arena) {
+  char buffer[1 << 16];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  s21::pmr::multiset<int> s21_set({3, 1, 3, 2}, std::less<int>(), &arena);
+  EXPECT_EQ(s21_set.size(), 4U);
+  EXPECT_EQ(s21_set.count(3), 2U);
+  EXPECT_EQ(s21_set.get_allocator().resource(), &arena);
+}
+
+TEST(multisetTest, node_handle) {
+  s21::multiset<int> s21_set = {1, 2, 2, 3};
+  auto nh = s21_set.extract(2);
+  EXPECT_EQ(s21_set.count(2), 1U);
+  nh.value() = 3;
+  auto it = s21_set.insert(std::move(nh));
+  EXPECT_EQ(*it, 3);
+  EXPECT_EQ(s21_set.count(3), 2U);
+  EXPECT_EQ(s21_set.size(), 4U);
+}
+
+TEST(multisetTest, hinted_insert) {
+  s21::multiset<int> s21_set;
+  std::multiset<int> std_set;
+  for (int i = 0; i < 300; ++i) {
+    s21_set.insert(s21_set.end(), i / 3);
+    std_set.insert(std_set.end(), i / 3);
+  }
+  s21_set.insert(s21_set.find(50), 50);
+  s21_set.insert(s21_set.begin(), 99);
+  s21_set.emplace_hint(s21_set.end(), 0);
+  std_set.insert({50, 99, 0});
+  EXPECT_EQ(s21_set.count(50), 4U);
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  auto std_it = std_set.begin();
+  for (auto s21_it = s21_set.begin(); s21_it != s21_set.end(); ++s21_it) {
+    EXPECT_EQ(*s21_it, *std_it++);
+  }
+}
+
+TEST(multisetTest, build_from_sorted_range) {
+  std::vector<int> keys = {1, 1, 2, 3, 3, 3, 8};
+  s21::multiset<int> s21_set(keys.begin(), keys.end());
+  EXPECT_EQ(s21_set.size(), keys.size());
+  EXPECT_EQ(s21_set.count(3), 3U);
+  EXPECT_TRUE(std::equal(keys.begin(), keys.end(), s21_set.begin()));
+  keys.push_back(0);
+  s21_set.assign_sorted(keys.begin(), keys.end());
+  EXPECT_EQ(s21_set.size(), keys.size());
+  EXPECT_EQ(*s21_set.begin(), 0);
+}
+
+TEST(multisetTest, emplace) {
+  s21::multiset<std::string> s21_set;
+  s21_set.emplace(3, 'a');
+  s21_set.emplace("aaa");
+  auto it = s21_set.emplace(2, 'b');
+  EXPECT_EQ(*it, "bb");
+  EXPECT_EQ(s21_set.count("aaa"), 2U);
+  EXPECT_EQ(s21_set.size(), 3U);
+}
+
+TEST(multisetTest, order_statistics) {
+  s21::multiset<int, std::less<int>, std::allocator<int>, true> s21_set = {
+      5, 1, 5, 3, 5, 9, 1};
+  EXPECT_EQ(*s21_set.nth(0), 1);
+  EXPECT_EQ(*s21_set.nth(4), 5);
+  EXPECT_EQ(*s21_set.nth(6), 9);
+  EXPECT_EQ(s21_set.rank(5), 3U);
+  EXPECT_EQ(s21_set.count_range(3, 6), 4U);
+  s21_set.erase(s21_set.find(5));
+  EXPECT_EQ(s21_set.count_range(5, 6), 2U);
+  EXPECT_EQ(s21_set.rank(9), 5U);
+  auto nh = s21_set.extract(1);
+  EXPECT_EQ(*s21_set.begin(), 1);
+  EXPECT_EQ(s21_set.rank(5), 2U);
+  EXPECT_EQ(*s21_set.nth(0), 1);
+}
+
+TEST(multisetTest, count_runs) {
+  s21::multiset<int> plain = {4, 2, 4, 8, 4, 2, 9};
+  s21::multiset<int, std::less<int>, std::allocator<int>, true> ranked = {
+      4, 2, 4, 8, 4, 2, 9};
+  for (int key = 0; key < 11; ++key) {
+    std::size_t expected = 0;
+    for (int value : plain) expected += value == key;
+    EXPECT_EQ(plain.count(key), expected);
+    EXPECT_EQ(ranked.count(key), expected);
+  }
+  ranked.erase(ranked.find(4));
+  EXPECT_EQ(ranked.count(4), 2U);
+}
+
+TEST(multisetTest, split_and_join) {
+  s21::multiset<int, std::less<int>, std::allocator<int>, true> lower = {
+      1, 3, 3, 3, 5, 7, 7};
+  auto upper = lower.split(3);
+  EXPECT_EQ(lower.size(), 1U);
+  EXPECT_EQ(upper.size(), 6U);
+  EXPECT_EQ(upper.count(3), 3U);
+  EXPECT_EQ(upper.rank(7), 4U);
+  EXPECT_EQ(*upper.nth(4), 7);
+  auto tail = upper.split(7);
+  upper.join(tail);
+  lower.join(upper);
+  EXPECT_EQ(lower.size(), 7U);
+  EXPECT_EQ(lower.rank(5), 4U);
+  EXPECT_EQ(*lower.nth(6), 7);
+  auto same = lower.split(0);
+  lower.join(same);
+  EXPECT_EQ(lower.count(7), 2U);
+  EXPECT_EQ(*lower.begin(), 1);
+}
+
+TEST(multisetTest, set_algebra) {
+  s21::multiset<int> a = {1, 1, 1, 2, 3};
+  s21::multiset<int> b = {1, 2, 2, 4};
+  s21::multiset<int> both = s21::set_union(a, b);
+  EXPECT_EQ(both.size(), 7U);
+  EXPECT_EQ(both.count(1), 3U);
+  EXPECT_EQ(both.count(2), 2U);
+  s21::multiset<int> common = s21::set_intersection(a, b);
+  EXPECT_EQ(common.size(), 2U);
+  EXPECT_EQ(common.count(1), 1U);
+  s21::multiset<int> only_a = s21::set_difference(a, b);
+  EXPECT_EQ(only_a.size(), 3U);
+  EXPECT_EQ(only_a.count(1), 2U);
+  EXPECT_EQ(only_a.count(3), 1U);
+  s21::multiset<int> either = s21::set_symmetric_difference(a, b);
+  EXPECT_EQ(either.size(), 5U);
+  EXPECT_EQ(either.count(2), 1U);
+  EXPECT_EQ(either.count(4), 1U);
+}
+
 int main(int argc, char *argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <string_view>
+
 #include "../s21_containers.h"
 
 TEST(setTest, constructor) {
@@ -484,6 +486,474 @@ TEST(setTest, test24) {
   EXPECT_EQ(*it3, *it4);
 }
 
+struct ModuloLess {
+  int mod = 10;
+  bool operator()(int a, int b) const { return a % mod < b % mod; }
+};
+
+TEST(setTest, custom_compare) {
+  s21::set<int, std::greater<int>> s21_set = {1, 5, 3, 4, 2};
+  std::set<int, std::greater<int>> std_set = {1, 5, 3, 4, 2};
+  auto s21_it = s21_set.begin();
+  for (auto std_it = std_set.begin(); std_it != std_set.end();
+       std_it++, s21_it++) {
+    EXPECT_EQ(*s21_it, *std_it);
+  }
+  EXPECT_TRUE(s21_set.contains(4));
+  EXPECT_FALSE(s21_set.contains(6));
+  EXPECT_FALSE(s21_set.insert(3).second);
+  EXPECT_EQ(sizeof(s21::set<int>), sizeof(s21::set<int, std::greater<int>>));
+}
+
+TEST(setTest, stateful_compare) {
+  s21::set<int, ModuloLess> s21_set(ModuloLess{7});
+  for (int i = 0; i < 20; ++i) s21_set.insert(i);
+  EXPECT_EQ(s21_set.size(), 7U);
+  EXPECT_EQ(s21_set.key_comp().mod, 7);
+  EXPECT_TRUE(s21_set.contains(15));
+  EXPECT_EQ(*s21_set.find(15), 1);
+
+  s21::set<int, ModuloLess> s21_copy(s21_set);
+  EXPECT_EQ(s21_copy.key_comp().mod, 7);
+  EXPECT_FALSE(s21_copy.insert(8).second);
+}
+
+TEST(setTest, insert_erase_matches_std) {
+  s21::set<int> s21_set;
+  std::set<int> std_set;
+  unsigned seed = 42;
+  for (int i = 0; i < 5000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int key = (seed >> 8) % 1000;
+    if (i % 3 == 2) {
+      auto it = s21_set.find(key);
+      if (it != s21_set.end()) s21_set.erase(it);
+      std_set.erase(key);
+    } else {
+      EXPECT_EQ(s21_set.insert(key).second, std_set.insert(key).second);
+    }
+  }
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  auto s21_it = s21_set.begin();
+  for (auto std_it = std_set.begin(); std_it != std_set.end();
+       std_it++, s21_it++) {
+    EXPECT_EQ(*s21_it, *std_it);
+  }
+}
+
+TEST(setTest, transparent_lookup) {
+  s21::set<std::string, std::less<>> s21_set = {"alpha", "beta", "gamma"};
+  std::string_view beta = "beta";
+
+  EXPECT_TRUE(s21_set.contains(beta));
+  EXPECT_FALSE(s21_set.contains("delta"));
+  EXPECT_EQ(*s21_set.find(beta), "beta");
+  EXPECT_EQ(s21_set.find("delta"), s21_set.end());
+  EXPECT_EQ(s21_set.count("gamma"), 1U);
+  EXPECT_EQ(*s21_set.lower_bound("b"), "beta");
+  EXPECT_EQ(*s21_set.upper_bound(beta), "gamma");
+  auto range = s21_set.equal_range(beta);
+  EXPECT_EQ(*range.first, "beta");
+  EXPECT_EQ(*range.second, "gamma");
+}
+
+TEST(setTest, node_pool_reuse) {
+  s21::set<int> s21_set;
+  for (int i = 0; i < 100; ++i) s21_set.insert(i);
+  s21::NodePoolStats stats = s21_set.pool_stats();
+  EXPECT_EQ(stats.in_use, 100U);
+  EXPECT_GE(stats.capacity, 100U);
+  EXPECT_LT(stats.chunks, 100U);
+
+  for (int i = 0; i < 50; ++i) s21_set.erase(s21_set.find(i));
+  EXPECT_EQ(s21_set.pool_stats().in_use, 50U);
+  EXPECT_EQ(s21_set.pool_stats().free, 50U);
+
+  for (int i = 0; i < 50; ++i) s21_set.insert(i);
+  EXPECT_EQ(s21_set.pool_stats().capacity, stats.capacity);
+  EXPECT_EQ(s21_set.pool_stats().free, 0U);
+
+  s21_set.clear();
+  EXPECT_EQ(s21_set.pool_stats().chunks, 0U);
+  EXPECT_EQ(s21_set.pool_stats().bytes, 0U);
+  s21_set.insert(7);
+  EXPECT_TRUE(s21_set.contains(7));
+}
+
+TEST(setTest, node_pool_shared) {
+  s21::set<std::string> set1 = {"a", "b", "c"};
+  s21::set<std::string> set2(set1.pool());
+  set2.insert("d");
+  set2.insert("e");
+  const std::string* d = &*set2.find("d");
+
+  set1.merge(set2);
+  EXPECT_EQ(set1.size(), 5U);
+  EXPECT_TRUE(set2.empty());
+  EXPECT_EQ(&*set1.find("d"), d);
+  EXPECT_EQ(set1.pool_stats().in_use, 5U);
+
+  s21::set<std::string> set3 = {"f", "a"};
+  set1.merge(set3);
+  EXPECT_EQ(set1.size(), 6U);
+  EXPECT_EQ(set3.size(), 1U);
+  EXPECT_EQ(set3.pool_stats().in_use, 1U);
+  EXPECT_EQ(*set1.find("f"), "f");
+}
+
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  std::size_t allocations = 0;
+  std::size_t live_bytes = 0;
+
+ private:
+  void *do_allocate(std::size_t bytes, std::size_t align) override {
+    ++allocations;
+    live_bytes += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, align);
+  }
+  void do_deallocate(void *p, std::size_t bytes, std::size_t align) override {
+    live_bytes -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+  }
+  bool do_is_equal(const memory_resource &other) const noexcept override {
+    return this == &other;
+  }
+};
+
+TEST(setTest, pmr_resource) {
+  CountingResource resource;
+  {
+    s21::pmr::set<int> s21_set(&resource);
+    for (int i = 0; i < 1000; ++i) s21_set.insert(i);
+    EXPECT_GT(resource.allocations, 0U);
+    EXPECT_GT(resource.live_bytes, 1000 * sizeof(int));
+    EXPECT_EQ(s21_set.get_allocator().resource(), &resource);
+
+    s21::pmr::set<int> s21_copy(s21_set, &resource);
+    EXPECT_EQ(s21_copy.size(), 1000U);
+  }
+  EXPECT_EQ(resource.live_bytes, 0U);
+}
+
+TEST(setTest, pmr_move_between_arenas) {
+  CountingResource arena1;
+  CountingResource arena2;
+  s21::pmr::set<int> set1({1, 2, 3}, std::less<int>(), &arena1);
+  s21::pmr::set<int> set2(&arena2);
+  set2 = std::move(set1);
+  EXPECT_EQ(set2.size(), 3U);
+  EXPECT_TRUE(set1.empty());
+  EXPECT_EQ(set2.get_allocator().resource(), &arena2);
+  set1.insert(4);
+  set1.clear();
+  EXPECT_GT(arena2.live_bytes, 0U);
+}
+
+TEST(setTest, pmr_monotonic_arena) {
+  char buffer[1 << 16];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  s21::pmr::set<int> s21_set(&arena);
+  for (int i = 0; i < 100; ++i) s21_set.insert(i);
+  EXPECT_EQ(s21_set.size(), 100U);
+  EXPECT_EQ(*s21_set.find(42), 42);
+}
+
+TEST(setTest, extract_keeps_bounds) {
+  s21::set<int> s21_set;
+  s21_set.insert(1);
+  s21_set.insert(2);
+  s21_set.insert(0);
+  s21_set.insert(-1);
+  s21_set.extract(0);
+  s21_set.extract(-1);
+  EXPECT_EQ(*s21_set.begin(), 1);
+  EXPECT_EQ(*--s21_set.end(), 2);
+  s21_set.extract(2);
+  s21_set.extract(1);
+  EXPECT_TRUE(s21_set.begin() == s21_set.end());
+  s21_set.insert(7);
+  EXPECT_EQ(*s21_set.begin(), 7);
+}
+
+TEST(setTest, node_handle_move_between_sets) {
+  s21::set<std::string> set1 = {"a", "b", "c"};
+  s21::set<std::string> set2(set1.pool());
+  const std::string* b = &*set1.find("b");
+  s21::NodePoolStats before = set1.pool_stats();
+
+  auto nh = set1.extract("b");
+  ASSERT_FALSE(nh.empty());
+  EXPECT_EQ(&nh.value(), b);
+  EXPECT_EQ(set1.size(), 2U);
+  nh.value() = "z";
+  auto res = set2.insert(std::move(nh));
+  EXPECT_TRUE(res.inserted);
+  EXPECT_TRUE(res.node.empty());
+  EXPECT_EQ(&*res.position, b);
+  EXPECT_EQ(*set2.begin(), "z");
+
+  s21::NodePoolStats after = set1.pool_stats();
+  EXPECT_EQ(after.in_use, before.in_use);
+  EXPECT_EQ(after.capacity, before.capacity);
+
+  set1.insert("z");
+  auto dup = set1.insert(set2.extract(set2.begin()));
+  EXPECT_FALSE(dup.inserted);
+  EXPECT_EQ(dup.node.value(), "z");
+  EXPECT_EQ(*dup.position, "z");
+  EXPECT_TRUE(set2.empty());
+}
+
+TEST(setTest, node_handle_outlives_set) {
+  s21::set<std::string>::node_type nh;
+  EXPECT_TRUE(nh.empty());
+  {
+    s21::set<std::string> source = {"x", "y"};
+    nh = source.extract(source.find("y"));
+    EXPECT_TRUE(source.extract("missing").empty());
+  }
+  EXPECT_EQ(nh.value(), "y");
+  s21::set<std::string> target = {"a"};
+  target.insert(std::move(nh));
+  EXPECT_EQ(target.size(), 2U);
+  EXPECT_TRUE(target.contains("y"));
+}
+
+TEST(setTest, hinted_insert) {
+  s21::set<int> s21_set;
+  std::set<int> std_set;
+  for (int i = 0; i < 1000; i += 2) {
+    s21_set.insert(s21_set.end(), i);
+    std_set.insert(std_set.end(), i);
+  }
+  auto it = s21_set.insert(s21_set.find(10), 9);
+  EXPECT_EQ(*it, 9);
+  it = s21_set.insert(s21_set.find(10), 11);
+  EXPECT_EQ(*it, 11);
+  it = s21_set.insert(s21_set.begin(), 500);
+  EXPECT_EQ(*it, 500);
+  it = s21_set.insert(s21_set.begin(), 998);
+  EXPECT_EQ(*it, 998);
+  it = s21_set.emplace_hint(s21_set.begin(), -1);
+  EXPECT_EQ(it, s21_set.begin());
+  std_set.insert({9, 11, -1});
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  auto std_it = std_set.begin();
+  for (auto s21_it = s21_set.begin(); s21_it != s21_set.end(); ++s21_it) {
+    EXPECT_EQ(*s21_it, *std_it++);
+  }
+  EXPECT_EQ(*--s21_set.end(), 998);
+}
+
+TEST(setTest, build_from_sorted_range) {
+  std::vector<int> keys;
+  for (int i = 0; i < 1000; ++i) keys.push_back(i / 2);
+  s21::set<int> s21_set(keys.begin(), keys.end());
+  EXPECT_EQ(s21_set.size(), 500U);
+  EXPECT_EQ(s21_set.pool_stats().chunks, 1U);
+  auto address = [&s21_set](int key) {
+    return reinterpret_cast<const char*>(&*s21_set.find(key));
+  };
+  std::ptrdiff_t stride = address(1) - address(0);
+  EXPECT_GT(stride, 0);
+  EXPECT_EQ(address(499) - address(0), 499 * stride);
+  int expected = 0;
+  for (int key : s21_set) EXPECT_EQ(key, expected++);
+  s21_set.insert(1000);
+  s21_set.erase(s21_set.find(250));
+  EXPECT_EQ(s21_set.size(), 500U);
+  EXPECT_EQ(*--s21_set.end(), 1000);
+}
+
+TEST(setTest, assign_sorted_unsorted_tail) {
+  std::vector<int> keys = {1, 2, 5, 7, 3, 9, 2, 0};
+  s21::set<int> s21_set = {42};
+  s21_set.assign_sorted(keys.begin(), keys.end());
+  std::set<int> std_set(keys.begin(), keys.end());
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  auto std_it = std_set.begin();
+  for (int key : s21_set) EXPECT_EQ(key, *std_it++);
+  EXPECT_FALSE(s21_set.contains(42));
+}
+
+struct Pinned {
+  Pinned() = default;
+  Pinned(int a, int b) : value(a * 10 + b) {}
+  Pinned(const Pinned&) = delete;
+  Pinned& operator=(const Pinned&) = delete;
+  bool operator<(const Pinned& other) const { return value < other.value; }
+  int value = 0;
+};
+
+TEST(setTest, emplace_in_place) {
+  s21::set<Pinned> s21_set;
+  auto res = s21_set.emplace(1, 2);
+  EXPECT_TRUE(res.second);
+  EXPECT_EQ((*res.first).value, 12);
+  s21_set.emplace(0, 5);
+  res = s21_set.emplace(1, 2);
+  EXPECT_FALSE(res.second);
+  EXPECT_EQ(s21_set.size(), 2U);
+  EXPECT_EQ((*s21_set.begin()).value, 5);
+}
+
+TEST(setTest, order_statistics) {
+  s21::set<int, std::less<int>, std::allocator<int>, true> s21_set;
+  std::set<int> std_set;
+  unsigned seed = 99;
+  for (int i = 0; i < 3000; ++i) {
+    seed = seed * 1103515245 + 12345;
+    int key = static_cast<int>(seed >> 16) % 2000;
+    if (i % 3 == 2) {
+      auto it = s21_set.find(key);
+      if (it != s21_set.end()) s21_set.erase(it);
+      std_set.erase(key);
+    } else if (i % 5 == 0) {
+      s21_set.insert(s21_set.end(), key);
+      std_set.insert(key);
+    } else {
+      s21_set.emplace(key);
+      std_set.insert(key);
+    }
+  }
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  std::size_t k = 0;
+  for (int key : std_set) {
+    EXPECT_EQ(*s21_set.nth(k), key);
+    EXPECT_EQ(s21_set.rank(key), k);
+    ++k;
+  }
+  EXPECT_EQ(s21_set.nth(k), s21_set.end());
+  EXPECT_EQ(s21_set.count_range(500, 1500),
+            static_cast<std::size_t>(std::distance(std_set.lower_bound(500),
+                                                   std_set.lower_bound(1500))));
+  EXPECT_EQ(s21_set.count_range(1500, 500), 0U);
+
+  std::vector<int> sorted(std_set.begin(), std_set.end());
+  s21::set<int, std::less<int>, std::allocator<int>, true> bulk(sorted.begin(),
+                                                                 sorted.end());
+  auto copy = bulk;
+  EXPECT_EQ(*copy.nth(sorted.size() / 2), sorted[sorted.size() / 2]);
+  EXPECT_EQ(copy.rank(sorted.back() + 1), sorted.size());
+}
+
+TEST(setTest, split_and_join) {
+  s21::set<int> lower;
+  for (int i = 0; i < 100; ++i) lower.insert(i);
+  const int* fifty = &*lower.find(50);
+  s21::set<int> upper = lower.split(50);
+  EXPECT_EQ(lower.size(), 50U);
+  EXPECT_EQ(upper.size(), 50U);
+  EXPECT_EQ(*--lower.end(), 49);
+  EXPECT_EQ(*upper.begin(), 50);
+  EXPECT_EQ(&*upper.find(50), fifty);
+  EXPECT_TRUE(lower.split(1000).empty());
+  EXPECT_EQ(lower.size(), 50U);
+
+  lower.join(upper);
+  EXPECT_TRUE(upper.empty());
+  EXPECT_EQ(lower.size(), 100U);
+  EXPECT_EQ(&*lower.find(50), fifty);
+  int expected = 0;
+  for (int value : lower) EXPECT_EQ(value, expected++);
+  EXPECT_EQ(expected, 100);
+
+  s21::set<int> overlap = {5, 200};
+  lower.join(overlap);
+  EXPECT_EQ(lower.size(), 101U);
+  EXPECT_EQ(overlap.size(), 1U);
+  EXPECT_EQ(*--lower.end(), 200);
+}
+
+TEST(setTest, set_algebra) {
+  s21::set<int> a = {1, 2, 3, 5, 8};
+  s21::set<int> b = {2, 3, 4, 8, 9};
+  auto equal = [](const s21::set<int>& set, std::initializer_list<int> want) {
+    if (set.size() != want.size()) return false;
+    auto it = set.begin();
+    for (int value : want)
+      if (*it++ != value) return false;
+    return true;
+  };
+  EXPECT_TRUE(equal(s21::set_union(a, b), {1, 2, 3, 4, 5, 8, 9}));
+  EXPECT_TRUE(equal(s21::set_intersection(a, b), {2, 3, 8}));
+  EXPECT_TRUE(equal(s21::set_difference(a, b), {1, 5}));
+  EXPECT_TRUE(equal(s21::set_symmetric_difference(a, b), {1, 4, 5, 9}));
+  EXPECT_TRUE(s21::set_intersection(a, s21::set<int>()).empty());
+
+  s21::set<int> big;
+  for (int i = 0; i < 10000; ++i) big.insert(i * 2);
+  s21::set<int> few = {-1, 4, 7, 19998, 20001};
+  EXPECT_TRUE(equal(s21::set_intersection(few, big), {4, 19998}));
+  EXPECT_TRUE(equal(s21::set_intersection(big, few), {4, 19998}));
+  EXPECT_TRUE(equal(s21::set_difference(few, big), {-1, 7, 20001}));
+  EXPECT_EQ(s21::set_difference(big, few).size(), 9998U);
+}
+
+TEST(setTest, node_is_four_words) {
+  // Key plus three pointers: the color shares a word with the parent.
+  s21::set<long long> s21_set = {3, 1, 2};
+  s21::NodePoolStats stats = s21_set.pool_stats();
+  EXPECT_EQ(stats.bytes / (stats.capacity + stats.chunks),
+            sizeof(long long) + 3 * sizeof(void*));
+  s21_set.erase(s21_set.find(2));
+  s21_set.insert(0);
+  int expected = 0;
+  for (long long key : s21_set) {
+    if (expected == 2) ++expected;
+    EXPECT_EQ(key, expected++);
+  }
+}
+
+TEST(setTest, arena_storage) {
+  s21::arena::set<int> s21_set;
+  std::set<int> std_set;
+  auto first = s21_set.insert(500).first;
+  std_set.insert(500);
+  for (int i = 0; i < 5000; ++i) {
+    int key = (i * 7919) % 3001;
+    EXPECT_EQ(s21_set.insert(key).second, std_set.insert(key).second);
+  }
+  EXPECT_EQ(*first, 500);
+  for (int key = 0; key < 3001; key += 3) {
+    auto it = s21_set.find(key);
+    if (it != s21_set.end()) s21_set.erase(it);
+    std_set.erase(key);
+  }
+  ASSERT_EQ(s21_set.size(), std_set.size());
+  auto it = s21_set.begin();
+  for (int key : std_set) EXPECT_EQ(*it++, key);
+  EXPECT_EQ(it, s21_set.end());
+  EXPECT_EQ(*--s21_set.end(), *std_set.rbegin());
+
+  s21::arena::set<int> copy(s21_set);
+  copy.insert(-1);
+  EXPECT_EQ(copy.size(), s21_set.size() + 1);
+  EXPECT_FALSE(s21_set.contains(-1));
+  EXPECT_EQ(*copy.lower_bound(0), 1);
+  EXPECT_EQ(*copy.upper_bound(1), 2);
+}
+
+TEST(setTest, arena_storage_layout) {
+  // Three 32-bit links next to the key instead of three pointers.
+  s21::arena::set<int> s21_set = {5, 1, 4, 2, 3, 2};
+  s21::NodePoolStats stats = s21_set.pool_stats();
+  EXPECT_EQ(stats.bytes / (stats.capacity + stats.chunks), 16U);
+  EXPECT_EQ(s21_set.size(), 5U);
+  s21::arena::set<int> other = {4, 5, 6, 7};
+  s21::arena::set<int> common = s21::set_intersection(s21_set, other);
+  s21::arena::set<int> all = s21::set_union(s21_set, other);
+  EXPECT_EQ(common.size(), 2U);
+  EXPECT_EQ(all.size(), 7U);
+  s21_set.merge(other);
+  EXPECT_EQ(s21_set.size(), 7U);
+  EXPECT_EQ(other.size(), 2U);
+  int expected = 1;
+  for (int key : s21_set) EXPECT_EQ(key, expected++);
+}
+
 int main(int argc, char *argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -86,6 +86,16 @@ TEST(Array, Swap) {
   ASSERT_EQ((test_array[2] == 8 && second_array[2] == -3), true);
 }
 
+TEST(Array, Copy_non_trivial) {
+  s21::Array<std::string, 3> test_array = {"a", "bb", "ccc"};
+  s21::Array<std::string, 3> copy_array(test_array);
+  s21::Array<std::string, 3> move_array(std::move(test_array));
+  for (size_t i = 0; i < copy_array.size(); i++) {
+    ASSERT_EQ(copy_array[i], move_array[i]);
+  }
+  ASSERT_EQ(move_array[2], "ccc");
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <list>
+#include <vector>
+
 #include "../s21_list.h"
 #include "gtest/gtest.h"
 
@@ -276,6 +280,39 @@ TEST(ListTest, Sort)
   EXPECT_EQ(l.back(), 3);
 }
 
+TEST(ListTest, SortMatchesStd)
+{
+  s21::list<int> l;
+  std::list<int> expected;
+  unsigned seed = 7;
+  for (int i = 0; i < 10000; ++i)
+  {
+    seed = seed * 1103515245 + 12345;
+    l.push_back(static_cast<int>(seed >> 16) % 1000);
+    expected.push_back(static_cast<int>(seed >> 16) % 1000);
+  }
+  l.sort();
+  expected.sort();
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+  EXPECT_EQ(*(--l.end()), expected.back());
+  EXPECT_EQ(l.size(), expected.size());
+}
+
+TEST(ListTest, SortIsStableAndKeepsNodes)
+{
+  using item = std::pair<int, int>;
+  s21::list<item> l = {{3, 0}, {1, 1}, {3, 2}, {2, 3}, {1, 4}, {3, 5}};
+  std::vector<const item *> addresses;
+  for (auto it = l.begin(); it != l.end(); ++it) addresses.push_back(&*it);
+  l.sort([](const item &a, const item &b) { return a.first > b.first; });
+  std::vector<item> expected = {{3, 0}, {3, 2}, {3, 5}, {2, 3}, {1, 1}, {1, 4}};
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), l.begin()));
+  for (auto it = l.begin(); it != l.end(); ++it)
+  {
+    EXPECT_EQ(&*it, addresses[it->second]);
+  }
+}
+
 TEST(ListTest, PopFrontOnEmpty)
 {
   s21::list<int> l;
@@ -306,6 +343,102 @@ TEST(ListTest, SpliceWithEmpty)
   EXPECT_EQ(l1.size(), 3);
 }
 
+TEST(ListTest, SpliceElementAndRange)
+{
+  s21::list<int> l1({1, 2, 3});
+  s21::list<int> l2({10, 20, 30, 40});
+  const int *twenty = &*(++l2.begin());
+  l1.splice(l1.begin(), l2, ++l2.begin());
+  EXPECT_EQ(&l1.front(), twenty);
+  EXPECT_EQ(l1.size(), 4);
+  EXPECT_EQ(l2.size(), 3);
+
+  auto first = ++l2.begin();
+  l1.splice(l1.end(), l2, first, l2.end());
+  std::vector<int> expected1 = {20, 1, 2, 3, 30, 40};
+  EXPECT_TRUE(std::equal(expected1.begin(), expected1.end(), l1.begin()));
+  EXPECT_EQ(l1.size(), 6);
+  EXPECT_EQ(l2.size(), 1);
+  EXPECT_EQ(l2.front(), 10);
+  EXPECT_EQ(l2.back(), 10);
+
+  l1.splice(l1.begin(), l1, ++l1.begin(), --l1.end());
+  std::vector<int> expected2 = {1, 2, 3, 30, 20, 40};
+  EXPECT_TRUE(std::equal(expected2.begin(), expected2.end(), l1.begin()));
+  EXPECT_EQ(l1.size(), 6);
+  EXPECT_EQ(*(--l1.end()), 40);
+}
+
+TEST(ListTest, MergeRelinksNodes)
+{
+  using item = std::pair<int, char>;
+  auto by_key = [](const item &a, const item &b) { return a.first < b.first; };
+  s21::list<item> l1({{1, 'a'}, {3, 'a'}, {3, 'a'}, {7, 'a'}});
+  s21::list<item> l2({{0, 'b'}, {3, 'b'}, {8, 'b'}, {9, 'b'}});
+  std::vector<const item *> nodes;
+  for (auto it = l2.begin(); it != l2.end(); ++it) nodes.push_back(&*it);
+  l1.merge(l2, by_key);
+  std::vector<item> expected = {{0, 'b'}, {1, 'a'}, {3, 'a'}, {3, 'a'},
+                                {3, 'b'}, {7, 'a'}, {8, 'b'}, {9, 'b'}};
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), l1.begin()));
+  EXPECT_EQ(l1.size(), 8);
+  EXPECT_TRUE(l2.empty());
+  EXPECT_EQ(&l1.front(), nodes[0]);
+  EXPECT_EQ(&l1.back(), nodes[3]);
+}
+
+TEST(ListTest, PmrSpliceAcrossArenas)
+{
+  std::pmr::monotonic_buffer_resource arena1, arena2;
+  s21::pmr::list<int> l1({1, 2}, &arena1);
+  s21::pmr::list<int> l2({3, 4}, &arena2);
+  l1.splice(l1.end(), l2);
+  EXPECT_EQ(l1.size(), 4);
+  EXPECT_EQ(l1.back(), 4);
+  EXPECT_TRUE(l2.empty());
+}
+
+TEST(ListTest, EmplaceInPlace)
+{
+  struct Pinned
+  {
+    Pinned() = default;
+    Pinned(int a, int b) : value(a * 10 + b) {}
+    Pinned(const Pinned &) = delete;
+    int value = 0;
+  };
+  s21::list<Pinned> l;
+  l.emplace_back(1, 2).value++;
+  l.emplace_front(0, 1);
+  auto it = l.emplace(++l.cbegin(), 0, 7);
+  EXPECT_EQ(it->value, 7);
+  EXPECT_EQ(l.size(), 3);
+  int expected[] = {1, 7, 13};
+  int i = 0;
+  for (auto cit = l.cbegin(); cit != l.cend(); ++cit)
+  {
+    EXPECT_EQ((*cit).value, expected[i++]);
+  }
+}
+
+TEST(ListTest, PmrMonotonicArena)
+{
+  char buffer[1 << 12];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  s21::pmr::list<int> l({1, 2, 3}, &arena);
+  l.push_back(4);
+  l.push_front(0);
+  EXPECT_EQ(l.size(), 5);
+  EXPECT_EQ(l.front(), 0);
+  EXPECT_EQ(l.back(), 4);
+  EXPECT_EQ(l.get_allocator().resource(), &arena);
+
+  s21::pmr::list<int> other(&arena);
+  other = std::move(l);
+  EXPECT_EQ(other.size(), 5);
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);
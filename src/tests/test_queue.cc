@@ -130,6 +130,19 @@ TEST(QueueTest, Swap)
   EXPECT_EQ(q2.front(), 1);
 }
 
+TEST(QueueTest, PmrMonotonicArena)
+{
+  char buffer[1 << 12];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  s21::pmr::queue<int> q(&arena);
+  q.push(1);
+  q.push(2);
+  q.pop();
+  EXPECT_EQ(q.front(), 2);
+  EXPECT_EQ(q.get_allocator().resource(), &arena);
+}
+
 int main(int argc, char *argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
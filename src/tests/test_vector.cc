@@ -314,13 +314,13 @@ TEST(Vector, Swap)
   ASSERT_EQ((s21_vector[0] == 6 && swap_vector[0] == 1), 1);
 }
 
-TEST(Vector, Emplace)
+TEST(Vector, Insert_many)
 {
   s21::Vector<double> v2 = {-2, 6, 5, 8};
 
   auto pos2 = v2.end();
   pos2 -= 1;
-  v2.emplace(pos2, 9, -1);
+  v2.insert_many(pos2, 9, -1);
 
   EXPECT_EQ(v2.size(), 6);
   EXPECT_EQ(v2.at(0), -2);
@@ -332,6 +332,230 @@ TEST(Vector, Emplace)
   }
 }
 
+TEST(Vector, Pmr_monotonic_arena)
+{
+  char buffer[1 << 16];
+  std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                            std::pmr::null_memory_resource());
+  s21::pmr::Vector<int> v(&arena);
+  for (int i = 0; i < 100; ++i)
+  {
+    v.push_back(i);
+  }
+  EXPECT_EQ(v.size(), 100);
+  EXPECT_EQ(v[99], 99);
+  EXPECT_EQ(v.get_allocator().resource(), &arena);
+}
+
+TEST(Vector, Push_back_geometric_growth)
+{
+  s21::Vector<int> v;
+  size_t reallocations = 0;
+  size_t capacity = v.capacity();
+  for (int i = 0; i < 10000000; ++i)
+  {
+    v.push_back(i);
+    if (v.capacity() != capacity)
+    {
+      ++reallocations;
+      capacity = v.capacity();
+    }
+  }
+  EXPECT_EQ(v.size(), 10000000);
+  EXPECT_EQ(v[9999999], 9999999);
+  EXPECT_LE(reallocations, 25);
+}
+
+TEST(Vector, Growth_policy)
+{
+  s21::Vector<int, std::allocator<int>, s21::HalfGrowth> v;
+  v.push_back(1);
+  v.push_back(2);
+  EXPECT_EQ(v.capacity(), 2);
+  v.push_back(3);
+  EXPECT_EQ(v.capacity(), 3);
+  v.push_back(4);
+  EXPECT_EQ(v.capacity(), 4);
+  v.push_back(5);
+  EXPECT_EQ(v.capacity(), 6);
+  v.insert(v.begin(), v[4]);
+  v.insert(v.begin(), 0);
+  EXPECT_EQ(v.capacity(), 9);
+  EXPECT_EQ(v[0], 0);
+  EXPECT_EQ(v[1], 5);
+  EXPECT_EQ(v[6], 5);
+}
+
+TEST(Vector, Push_back_own_element)
+{
+  s21::Vector<std::string> v = {"a", "b"};
+  v.push_back(v[0]);
+  v.push_back(v[1]);
+  EXPECT_EQ(v.size(), 4);
+  EXPECT_EQ(v[2], "a");
+  EXPECT_EQ(v[3], "b");
+}
+
+struct Tracked
+{
+  static inline int constructed = 0;
+  static inline int alive = 0;
+  explicit Tracked(int v) : value(v) { constructed++, alive++; }
+  Tracked(const Tracked &other) : value(other.value) { constructed++, alive++; }
+  Tracked &operator=(const Tracked &) = default;
+  ~Tracked() { alive--; }
+  int value;
+};
+
+TEST(Vector, Reserve_constructs_nothing)
+{
+  Tracked::constructed = 0;
+  {
+    s21::Vector<Tracked> v;
+    v.reserve(1000);
+    EXPECT_EQ(Tracked::constructed, 0);
+    v.push_back(Tracked(1));
+    v.push_back(Tracked(2));
+    v.insert(v.begin(), Tracked(0));
+    EXPECT_EQ(Tracked::alive, 3);
+    EXPECT_EQ(v[0].value, 0);
+    EXPECT_EQ(v[2].value, 2);
+    v.erase(v.begin());
+    v.pop_back();
+    EXPECT_EQ(Tracked::alive, 1);
+    s21::Vector<Tracked> copy(v);
+    EXPECT_EQ(copy.capacity(), 1);
+    EXPECT_EQ(copy[0].value, 1);
+    v.shrink_to_fit();
+    EXPECT_EQ(Tracked::alive, 2);
+  }
+  EXPECT_EQ(Tracked::alive, 0);
+}
+
+struct CopyCounted
+{
+  static inline int copies = 0;
+  CopyCounted() = default;
+  CopyCounted(const CopyCounted &) { copies++; }
+  CopyCounted(CopyCounted &&) noexcept {}
+  CopyCounted &operator=(const CopyCounted &)
+  {
+    copies++;
+    return *this;
+  }
+  CopyCounted &operator=(CopyCounted &&) noexcept { return *this; }
+};
+
+TEST(Vector, Move_assignment_steals_buffer)
+{
+  s21::Vector<int> a = {1, 2, 3};
+  s21::Vector<int> b = {4};
+  const int *data = a.data();
+  b = std::move(a);
+  EXPECT_EQ(b.data(), data);
+  EXPECT_EQ(b.size(), 3);
+  EXPECT_EQ(b[2], 3);
+  EXPECT_EQ(a.size(), 0);
+}
+
+TEST(Vector, Reallocation_moves_elements)
+{
+  s21::Vector<CopyCounted> v(4);
+  CopyCounted::copies = 0;
+  v.reserve(100);
+  v.shrink_to_fit();
+  v.insert(v.begin() + 2, CopyCounted());
+  EXPECT_EQ(CopyCounted::copies, 1);  // only the inserted value
+  s21::Vector<CopyCounted> w;
+  w = std::move(v);
+  EXPECT_EQ(CopyCounted::copies, 1);
+  EXPECT_EQ(w.size(), 5);
+}
+
+TEST(Vector, Trivial_insert_erase_matches_std)
+{
+  struct Point
+  {
+    int x;
+    double y;
+  };
+  s21::Vector<Point> v;
+  std::vector<Point> expected;
+  for (int i = 0; i < 1000; i++)
+  {
+    size_t pos = (i * 7) % (v.size() + 1);
+    v.insert(v.begin() + pos, Point{i, i * 0.5});
+    expected.insert(expected.begin() + pos, Point{i, i * 0.5});
+  }
+  for (int i = 0; i < 300; i++)
+  {
+    size_t pos = (i * 13) % v.size();
+    v.erase(v.begin() + pos);
+    expected.erase(expected.begin() + pos);
+  }
+  s21::Vector<Point> copy(v);
+  ASSERT_EQ(copy.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); i++)
+  {
+    EXPECT_EQ(copy[i].x, expected[i].x);
+    EXPECT_EQ(copy[i].y, expected[i].y);
+  }
+  EXPECT_ANY_THROW(v.erase(v.end()));
+}
+
+struct Emplaced
+{
+  static inline int copies_or_moves = 0;
+  Emplaced(int a, std::string b) : number(a), text(std::move(b)) {}
+  Emplaced(const Emplaced &other) : number(other.number), text(other.text)
+  {
+    copies_or_moves++;
+  }
+  Emplaced(Emplaced &&other) noexcept
+      : number(other.number), text(std::move(other.text))
+  {
+    copies_or_moves++;
+  }
+  Emplaced &operator=(Emplaced &&other) noexcept
+  {
+    number = other.number;
+    text = std::move(other.text);
+    copies_or_moves++;
+    return *this;
+  }
+  int number;
+  std::string text;
+};
+
+TEST(Vector, Emplace)
+{
+  s21::Vector<Emplaced> v;
+  v.reserve(4);
+  Emplaced::copies_or_moves = 0;
+  v.emplace_back(1, "one");
+  v.emplace(v.cbegin(), 0, "zero");
+  EXPECT_EQ(v.emplace_back(3, "three").number, 3);
+  // the shifted "one" and the temporary built for the front slot
+  EXPECT_EQ(Emplaced::copies_or_moves, 2);
+  auto it = v.emplace(v.cbegin() + 2, 2, "two");
+  EXPECT_EQ(it->text, "two");
+  EXPECT_EQ(v.size(), 4);
+  EXPECT_EQ(v.capacity(), 4);
+  for (size_t i = 0; i < v.size(); ++i)
+  {
+    EXPECT_EQ(v[i].number, static_cast<int>(i));
+  }
+}
+
+TEST(Vector, Emplace_own_element_on_growth)
+{
+  s21::Vector<std::string> v = {"a", "b"};
+  v.emplace(v.cbegin() + 1, v[0]);
+  v.emplace_back(v[2]);
+  std::vector<std::string> expected = {"a", "a", "b", "b"};
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), v.begin()));
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc, argv);